@@ -0,0 +1,99 @@
+# Reports the preprocessed line count and compile time of generated reflection files
+# for two output directories, usually the default output and the --lean-includes output.
+#
+# Usage:
+#   cmake -DCOMPILER=<c++ compiler> -DCOMPILER_ID=<GNU|Clang|MSVC>
+#         -DINCLUDE_DIRS=<dir;dir> -DBEFORE_DIR=<dir> -DAFTER_DIR=<dir>
+#         -P MeasureGeneratedCode.cmake
+
+foreach(var COMPILER BEFORE_DIR AFTER_DIR)
+    if(NOT DEFINED ${var})
+        message(FATAL_ERROR "MeasureGeneratedCode: ${var} is not set")
+    endif()
+endforeach()
+
+# Microsecond timestamps are only available from CMake 3.23 on
+if(CMAKE_VERSION VERSION_GREATER_EQUAL 3.23)
+    set(TIMESTAMP_FORMAT "%s%f")
+    set(TIMESTAMP_TICKS_PER_MS 1000)
+else()
+    set(TIMESTAMP_FORMAT "%s")
+    set(TIMESTAMP_TICKS_PER_MS 0)
+endif()
+
+set(INCLUDE_FLAGS "")
+foreach(dir ${INCLUDE_DIRS})
+    if(COMPILER_ID STREQUAL "MSVC")
+        list(APPEND INCLUDE_FLAGS "/I${dir}")
+    else()
+        list(APPEND INCLUDE_FLAGS "-I${dir}")
+    endif()
+endforeach()
+
+if(COMPILER_ID STREQUAL "MSVC")
+    set(PREPROCESS_FLAGS /nologo /std:c++latest /EP)
+    set(SYNTAX_FLAGS /nologo /std:c++latest /Zs)
+else()
+    set(PREPROCESS_FLAGS -std=c++23 -E -P)
+    set(SYNTAX_FLAGS -std=c++23 -fsyntax-only)
+endif()
+
+# Measure every generated file in a directory and return the totals
+function(measure_directory dir out_lines out_ms out_files)
+    file(GLOB generated_files "${dir}/*.generated.h" "${dir}/*.generated.cpp")
+    set(total_lines 0)
+    set(total_ms 0)
+    set(file_count 0)
+
+    foreach(generated ${generated_files})
+        execute_process(
+            COMMAND ${COMPILER} ${PREPROCESS_FLAGS} ${INCLUDE_FLAGS} ${generated}
+            OUTPUT_VARIABLE preprocessed
+            ERROR_QUIET
+        )
+        string(REGEX MATCHALL "\n" newlines "${preprocessed}")
+        list(LENGTH newlines lines)
+
+        string(TIMESTAMP start "${TIMESTAMP_FORMAT}")
+        execute_process(
+            COMMAND ${COMPILER} ${SYNTAX_FLAGS} ${INCLUDE_FLAGS} ${generated}
+            RESULT_VARIABLE compile_result
+            OUTPUT_QUIET
+            ERROR_QUIET
+        )
+        string(TIMESTAMP end "${TIMESTAMP_FORMAT}")
+
+        if(TIMESTAMP_TICKS_PER_MS)
+            math(EXPR elapsed_ms "(${end} - ${start}) / ${TIMESTAMP_TICKS_PER_MS}")
+        else()
+            math(EXPR elapsed_ms "(${end} - ${start}) * 1000")
+        endif()
+
+        set(status "")
+        if(NOT compile_result EQUAL 0)
+            set(status " (compile failed)")
+        endif()
+
+        get_filename_component(name ${generated} NAME)
+        message(STATUS "  ${name}: ${lines} lines, ${elapsed_ms} ms${status}")
+
+        math(EXPR total_lines "${total_lines} + ${lines}")
+        math(EXPR total_ms "${total_ms} + ${elapsed_ms}")
+        math(EXPR file_count "${file_count} + 1")
+    endforeach()
+
+    set(${out_lines} ${total_lines} PARENT_SCOPE)
+    set(${out_ms} ${total_ms} PARENT_SCOPE)
+    set(${out_files} ${file_count} PARENT_SCOPE)
+endfunction()
+
+message(STATUS "Before: ${BEFORE_DIR}")
+measure_directory(${BEFORE_DIR} before_lines before_ms before_files)
+
+message(STATUS "After: ${AFTER_DIR}")
+measure_directory(${AFTER_DIR} after_lines after_ms after_files)
+
+message(STATUS "")
+message(STATUS "Generated files:      ${before_files} -> ${after_files}")
+message(STATUS "Preprocessed lines:   ${before_lines} -> ${after_lines}")
+message(STATUS "Compile time (ms):    ${before_ms} -> ${after_ms}")
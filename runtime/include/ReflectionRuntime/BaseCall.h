@@ -0,0 +1,33 @@
+#pragma once
+
+#include <type_traits>
+#include <utility>
+
+namespace ReflectionRuntime {
+
+template <typename Base, typename Object>
+using BasePart = std::conditional_t<std::is_const_v<Object>, const Base, Base>;
+
+/**
+ * Base class part of a generated function. The generator passes the call on the base
+ * as a generic lambda whose return type names the function, so the lambda only accepts
+ * bases that have it; bases without it, like the engine's root GObject, give fallback.
+ * The objects reach the lambda as Base, functions of the class rather than of an object
+ * get a null const Base*.
+ */
+template <typename Base, typename Fallback, typename Call, typename... Objects>
+constexpr auto CallBase(Fallback fallback, Call&& call, Objects&... objects) {
+    if constexpr (sizeof...(Objects) == 0) {
+        if constexpr (std::is_invocable_v<Call, const Base*>) {
+            return std::forward<Call>(call)(static_cast<const Base*>(nullptr));
+        } else {
+            return fallback;
+        }
+    } else if constexpr (std::is_invocable_v<Call, BasePart<Base, Objects>&...>) {
+        return std::forward<Call>(call)(static_cast<BasePart<Base, Objects>&>(objects)...);
+    } else {
+        return fallback;
+    }
+}
+
+} // namespace ReflectionRuntime
@@ -0,0 +1,74 @@
+#pragma once
+
+#include "ReflectionRuntime/Serialization.h"
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+#include <span>
+
+namespace ReflectionRuntime {
+
+/**
+ * Bytes gathered on the stack before each write of a column
+ */
+inline constexpr size_t kBatchChunkBytes = 4096;
+
+/**
+ * Write one property of every object as a contiguous column.
+ * Bulk-copyable values are gathered into a stack buffer and written a chunk at a time,
+ * bools are converted to bytes, everything else goes through Write per element.
+ */
+template <typename Serializer, typename Object, typename T>
+void WriteColumn(Serializer& serializer, std::span<const Object> objects, T Object::* member) {
+    if constexpr (std::is_same_v<T, bool> || (kBulkCopy && IsBulkCopyable<T>)) {
+        constexpr size_t kElementSize = std::is_same_v<T, bool> ? 1 : sizeof(T);
+        constexpr size_t kChunkSize = std::max<size_t>(kBatchChunkBytes / kElementSize, 1);
+        alignas(T) std::byte chunk[kChunkSize * kElementSize];
+
+        for (size_t begin = 0; begin < objects.size(); begin += kChunkSize) {
+            size_t count = std::min(kChunkSize, objects.size() - begin);
+            for (size_t i = 0; i < count; ++i) {
+                if constexpr (std::is_same_v<T, bool>) {
+                    chunk[i] = std::byte{objects[begin + i].*member ? uint8_t(1) : uint8_t(0)};
+                } else {
+                    std::memcpy(chunk + i * kElementSize, &(objects[begin + i].*member), kElementSize);
+                }
+            }
+            serializer.WriteBytes(chunk, count * kElementSize);
+        }
+    } else {
+        for (const auto& object : objects) {
+            Write(serializer, object.*member);
+        }
+    }
+}
+
+/**
+ * Read a column written by WriteColumn into one property of every object
+ */
+template <typename Deserializer, typename Object, typename T>
+void ReadColumn(Deserializer& deserializer, std::span<Object> objects, T Object::* member) {
+    if constexpr (std::is_same_v<T, bool> || (kBulkCopy && IsBulkCopyable<T>)) {
+        constexpr size_t kElementSize = std::is_same_v<T, bool> ? 1 : sizeof(T);
+        constexpr size_t kChunkSize = std::max<size_t>(kBatchChunkBytes / kElementSize, 1);
+        alignas(T) std::byte chunk[kChunkSize * kElementSize];
+
+        for (size_t begin = 0; begin < objects.size(); begin += kChunkSize) {
+            size_t count = std::min(kChunkSize, objects.size() - begin);
+            deserializer.ReadBytes(chunk, count * kElementSize);
+            for (size_t i = 0; i < count; ++i) {
+                if constexpr (std::is_same_v<T, bool>) {
+                    objects[begin + i].*member = chunk[i] != std::byte{0};
+                } else {
+                    std::memcpy(&(objects[begin + i].*member), chunk + i * kElementSize, kElementSize);
+                }
+            }
+        }
+    } else {
+        for (auto& object : objects) {
+            Read(deserializer, object.*member);
+        }
+    }
+}
+
+} // namespace ReflectionRuntime
@@ -0,0 +1,293 @@
+#pragma once
+
+#include "ReflectionRuntime/Serialization.h"
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <span>
+#include <type_traits>
+#include <vector>
+
+namespace ReflectionRuntime {
+
+/**
+ * Writes values as a little-endian bit stream. Generated SerializeCompact functions
+ * append to it; Flush hands the bytes to a serializer with a length prefix. A writer
+ * can be reused for many objects, e.g. everything sent in one network packet.
+ */
+class BitWriter {
+public:
+    /**
+     * Append the low count bits of value, count at most 64
+     */
+    void WriteBits(uint64_t value, unsigned count) {
+        if (count > 56) {
+            WriteBits(value & 0xFFFFFFFFull, 32);
+            value >>= 32;
+            count -= 32;
+        }
+        m_bits |= (value & ((uint64_t(1) << count) - 1)) << m_count;
+        m_count += count;
+        while (m_count >= 8) {
+            m_bytes.push_back(static_cast<uint8_t>(m_bits));
+            m_bits >>= 8;
+            m_count -= 8;
+        }
+    }
+
+    /**
+     * Append raw bytes, used by Write for strings, vectors and other byte-encoded values
+     */
+    void WriteBytes(const void* data, size_t size) {
+        const auto* bytes = static_cast<const uint8_t*>(data);
+        if (m_count == 0) {
+            m_bytes.insert(m_bytes.end(), bytes, bytes + size);
+            return;
+        }
+        for (size_t i = 0; i < size; ++i) {
+            WriteBits(bytes[i], 8);
+        }
+    }
+
+    /**
+     * Bytes written so far, the last partial byte included
+     */
+    std::span<const uint8_t> GetBytes() {
+        if (m_count > 0) {
+            m_bytes.push_back(static_cast<uint8_t>(m_bits));
+            m_bits = 0;
+            m_count = 0;
+        }
+        return m_bytes;
+    }
+
+    /**
+     * Write the bytes as one length-prefixed block and start over
+     */
+    template <typename Serializer>
+    void Flush(Serializer& serializer) {
+        auto bytes = GetBytes();
+        WriteLength(serializer, bytes.size());
+        serializer.WriteBytes(bytes.data(), bytes.size());
+        m_bytes.clear();
+    }
+
+private:
+    std::vector<uint8_t> m_bytes;
+    uint64_t m_bits = 0;
+    unsigned m_count = 0;
+};
+
+/**
+ * Reads a bit stream written by BitWriter. Reading past the end yields zero bits and
+ * makes IsValid return false, so a truncated buffer is checked once at the end. Values
+ * outside their declared range do the same through Fail.
+ */
+class BitReader {
+public:
+    BitReader() = default;
+    explicit BitReader(std::span<const uint8_t> bytes) : m_data(bytes) {}
+
+    /**
+     * Read one block written by BitWriter::Flush from a deserializer
+     */
+    template <typename Deserializer>
+    void Load(Deserializer& deserializer) {
+        m_storage.resize(ReadLength(deserializer));
+        deserializer.ReadBytes(m_storage.data(), m_storage.size());
+        m_data = m_storage;
+        m_position = 0;
+        m_overrun = false;
+        m_failed = false;
+    }
+
+    /**
+     * Read count bits, count at most 64
+     */
+    uint64_t ReadBits(unsigned count) {
+        if (count > 56) {
+            uint64_t low = ReadBits(32);
+            return low | (ReadBits(count - 32) << 32);
+        }
+        if (m_position + count > m_data.size() * 8) {
+            m_overrun = true;
+            m_position = m_data.size() * 8;
+            return 0;
+        }
+
+        // One unaligned load covers any read of up to 56 bits
+        size_t byte = m_position / 8;
+        uint64_t word = 0;
+        std::memcpy(&word, m_data.data() + byte, std::min<size_t>(8, m_data.size() - byte));
+        if constexpr (std::endian::native == std::endian::big) {
+            word = ByteSwap(word);
+        }
+        uint64_t value = (word >> (m_position % 8)) & ((uint64_t(1) << count) - 1);
+        m_position += count;
+        return value;
+    }
+
+    void ReadBytes(void* data, size_t size) {
+        auto* bytes = static_cast<uint8_t*>(data);
+        if (m_position % 8 == 0 && m_position / 8 + size <= m_data.size()) {
+            std::memcpy(bytes, m_data.data() + m_position / 8, size);
+            m_position += size * 8;
+            return;
+        }
+        for (size_t i = 0; i < size; ++i) {
+            bytes[i] = static_cast<uint8_t>(ReadBits(8));
+        }
+    }
+
+    /**
+     * Mark the stream invalid, for values the bits cannot have come from a BitWriter
+     */
+    void Fail() noexcept { m_failed = true; }
+
+    bool IsValid() const noexcept { return !m_overrun && !m_failed; }
+
+private:
+    std::vector<uint8_t> m_storage;
+    std::span<const uint8_t> m_data;
+    size_t m_position = 0;
+    bool m_overrun = false;
+    bool m_failed = false;
+};
+
+/**
+ * Bits needed for every value of the range [Min, Max]
+ */
+template <auto Min, auto Max>
+inline constexpr unsigned kRangeBits = static_cast<unsigned>(
+    std::bit_width(static_cast<uint64_t>(static_cast<int64_t>(Max) - static_cast<int64_t>(Min))));
+
+/**
+ * Write an integer or enum clamped to [Min, Max] in the minimum number of bits
+ */
+template <auto Min, auto Max, typename T>
+void WriteClamped(BitWriter& writer, const T& value) {
+    int64_t integer = static_cast<int64_t>(value);
+    integer = std::clamp<int64_t>(integer, static_cast<int64_t>(Min), static_cast<int64_t>(Max));
+    writer.WriteBits(static_cast<uint64_t>(integer - static_cast<int64_t>(Min)), kRangeBits<Min, Max>);
+}
+
+/**
+ * Read a value written by WriteClamped. The bits can hold more than the range; such a
+ * value is clamped to Max and marks the reader invalid.
+ */
+template <auto Min, auto Max, typename T>
+void ReadClamped(BitReader& reader, T& value) {
+    constexpr uint64_t kRange = static_cast<uint64_t>(static_cast<int64_t>(Max) - static_cast<int64_t>(Min));
+    uint64_t offset = reader.ReadBits(kRangeBits<Min, Max>);
+    if (offset > kRange) {
+        reader.Fail();
+        offset = kRange;
+    }
+    value = static_cast<T>(static_cast<int64_t>(offset) + static_cast<int64_t>(Min));
+}
+
+/**
+ * Write a float clamped to [Min, Max] as one of 2^Bits evenly spaced steps, rounding to
+ * the nearest. Both ends of the range are represented exactly.
+ */
+template <auto Min, auto Max, unsigned Bits, typename T>
+void WriteQuantized(BitWriter& writer, const T& value) {
+    static_assert(Bits > 0 && Bits <= 32);
+    constexpr double kMin = static_cast<double>(Min);
+    constexpr double kScale = double((uint64_t(1) << Bits) - 1) / (static_cast<double>(Max) - kMin);
+    double clamped = std::clamp(static_cast<double>(value), kMin, static_cast<double>(Max));
+    writer.WriteBits(static_cast<uint64_t>(std::lround((clamped - kMin) * kScale)), Bits);
+}
+
+template <auto Min, auto Max, unsigned Bits, typename T>
+void ReadQuantized(BitReader& reader, T& value) {
+    constexpr double kMin = static_cast<double>(Min);
+    constexpr double kStep = (static_cast<double>(Max) - kMin) / double((uint64_t(1) << Bits) - 1);
+    value = static_cast<T>(kMin + static_cast<double>(reader.ReadBits(Bits)) * kStep);
+}
+
+/**
+ * LEB128 variable-length integer: 7 bits per byte, high bit set on all but the last
+ */
+inline void WriteVarint(BitWriter& writer, uint64_t value) {
+    while (value >= 0x80) {
+        writer.WriteBits((value & 0x7F) | 0x80, 8);
+        value >>= 7;
+    }
+    writer.WriteBits(value, 8);
+}
+
+inline uint64_t ReadVarint(BitReader& reader) {
+    uint64_t value = 0;
+    for (unsigned shift = 0; shift < 64; shift += 7) {
+        uint64_t byte = reader.ReadBits(8);
+        value |= (byte & 0x7F) << shift;
+        if ((byte & 0x80) == 0 || !reader.IsValid()) {
+            break;
+        }
+    }
+    return value;
+}
+
+/**
+ * Zigzag mapping of signed integers, so small negative values get short varints
+ */
+constexpr uint64_t ZigZagEncode(int64_t value) noexcept {
+    return (static_cast<uint64_t>(value) << 1) ^ static_cast<uint64_t>(value >> 63);
+}
+
+constexpr int64_t ZigZagDecode(uint64_t value) noexcept {
+    return static_cast<int64_t>(value >> 1) ^ -static_cast<int64_t>(value & 1);
+}
+
+/**
+ * Compact encoding of properties without a clamp range: bool as one bit, integers and
+ * enums as (zigzag) varints, floating point values as their bits, types with a
+ * SerializeCompact overload through it, everything else in the regular binary format
+ */
+template <typename T>
+void WriteCompact(BitWriter& writer, const T& value) {
+    if constexpr (std::is_same_v<T, bool>) {
+        writer.WriteBits(value ? 1 : 0, 1);
+    } else if constexpr (std::is_enum_v<T>) {
+        WriteCompact(writer, static_cast<std::underlying_type_t<T>>(value));
+    } else if constexpr (std::is_integral_v<T> && std::is_signed_v<T>) {
+        WriteVarint(writer, ZigZagEncode(value));
+    } else if constexpr (std::is_integral_v<T>) {
+        WriteVarint(writer, value);
+    } else if constexpr (std::is_floating_point_v<T>) {
+        using Bits = std::conditional_t<sizeof(T) == 4, uint32_t, uint64_t>;
+        writer.WriteBits(std::bit_cast<Bits>(value), sizeof(T) * 8);
+    } else if constexpr (requires { SerializeCompact(writer, value); }) {
+        SerializeCompact(writer, value);
+    } else {
+        Write(writer, value);
+    }
+}
+
+template <typename T>
+void ReadCompact(BitReader& reader, T& value) {
+    if constexpr (std::is_same_v<T, bool>) {
+        value = reader.ReadBits(1) != 0;
+    } else if constexpr (std::is_enum_v<T>) {
+        std::underlying_type_t<T> underlying{};
+        ReadCompact(reader, underlying);
+        value = static_cast<T>(underlying);
+    } else if constexpr (std::is_integral_v<T> && std::is_signed_v<T>) {
+        value = static_cast<T>(ZigZagDecode(ReadVarint(reader)));
+    } else if constexpr (std::is_integral_v<T>) {
+        value = static_cast<T>(ReadVarint(reader));
+    } else if constexpr (std::is_floating_point_v<T>) {
+        using Bits = std::conditional_t<sizeof(T) == 4, uint32_t, uint64_t>;
+        value = std::bit_cast<T>(static_cast<Bits>(reader.ReadBits(sizeof(T) * 8)));
+    } else if constexpr (requires { DeserializeCompact(reader, value); }) {
+        DeserializeCompact(reader, value);
+    } else {
+        Read(reader, value);
+    }
+}
+
+} // namespace ReflectionRuntime
@@ -0,0 +1,116 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <memory>
+#include <span>
+#include <string_view>
+#include <utility>
+
+namespace ReflectionRuntime {
+
+/**
+ * Contiguous growable array holding one property of every element of a generated
+ * structure-of-arrays container. Unlike std::vector it stores bool as a plain bool
+ * array, so every column can be handed out as a pointer and a size.
+ */
+template <typename T>
+class Column {
+public:
+    Column() = default;
+
+    Column(const Column& other) { *this = other; }
+    Column(Column&&) noexcept = default;
+
+    Column& operator=(const Column& other) {
+        if (this != &other) {
+            Clear();
+            Reserve(other.m_size);
+            std::copy(other.m_data.get(), other.m_data.get() + other.m_size, m_data.get());
+            m_size = other.m_size;
+        }
+        return *this;
+    }
+    Column& operator=(Column&&) noexcept = default;
+
+    size_t Size() const noexcept { return m_size; }
+    size_t Capacity() const noexcept { return m_capacity; }
+
+    T* Data() noexcept { return m_data.get(); }
+    const T* Data() const noexcept { return m_data.get(); }
+
+    std::span<T> GetSpan() noexcept { return {m_data.get(), m_size}; }
+    std::span<const T> GetSpan() const noexcept { return {m_data.get(), m_size}; }
+
+    T& operator[](size_t index) noexcept { return m_data[index]; }
+    const T& operator[](size_t index) const noexcept { return m_data[index]; }
+
+    void Reserve(size_t capacity) {
+        if (capacity <= m_capacity) {
+            return;
+        }
+        auto data = std::make_unique<T[]>(capacity);
+        std::move(m_data.get(), m_data.get() + m_size, data.get());
+        m_data = std::move(data);
+        m_capacity = capacity;
+    }
+
+    void PushBack(const T& value) {
+        if (m_size == m_capacity) {
+            Reserve(std::max<size_t>(m_capacity * 2, 16));
+        }
+        m_data[m_size++] = value;
+    }
+
+    /**
+     * Remove an element and keep the order of the others
+     */
+    void Erase(size_t index) {
+        std::move(m_data.get() + index + 1, m_data.get() + m_size, m_data.get() + index);
+        m_data[--m_size] = T{};
+    }
+
+    /**
+     * Remove an element in constant time by moving the last one into its place
+     */
+    void SwapErase(size_t index) {
+        if (index + 1 != m_size) {
+            m_data[index] = std::move(m_data[m_size - 1]);
+        }
+        m_data[--m_size] = T{};
+    }
+
+    void Clear() {
+        std::fill(m_data.get(), m_data.get() + m_size, T{});
+        m_size = 0;
+    }
+
+private:
+    std::unique_ptr<T[]> m_data;
+    size_t m_size = 0;
+    size_t m_capacity = 0;
+};
+
+/**
+ * Reflection description of one column of a structure-of-arrays container
+ */
+struct ColumnDescriptor {
+    std::string_view name;
+    size_t elementSize = 0;
+    size_t elementAlignment = 0;
+};
+
+/**
+ * Type-erased access to the elements of one column
+ */
+struct ColumnView {
+    void* data = nullptr;
+    size_t size = 0;
+    size_t stride = 0;
+
+    void* GetElementPtr(size_t index) const noexcept {
+        return static_cast<char*>(data) + index * stride;
+    }
+};
+
+} // namespace ReflectionRuntime
@@ -0,0 +1,104 @@
+#pragma once
+
+#include <bit>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+
+namespace ReflectionRuntime {
+
+/**
+ * Packed set of changed properties of a GCLASS(Replicated) object, one bit per Save
+ * property in declaration order. The class holds it as a data member with at least
+ * as many bits as it has Save properties, the generator finds it by its type.
+ */
+template <size_t Bits>
+class DirtyBits {
+public:
+    static constexpr size_t kSize = Bits;
+
+    void Set(size_t bit) noexcept { m_words[bit / 64] |= uint64_t(1) << (bit % 64); }
+    void Reset(size_t bit) noexcept { m_words[bit / 64] &= ~(uint64_t(1) << (bit % 64)); }
+    bool Test(size_t bit) const noexcept { return (m_words[bit / 64] >> (bit % 64)) & 1; }
+
+    void SetAll(size_t count) noexcept {
+        for (size_t bit = 0; bit < count; ++bit) {
+            Set(bit);
+        }
+    }
+
+    void Clear() noexcept {
+        for (auto& word : m_words) {
+            word = 0;
+        }
+    }
+
+    bool Any() const noexcept {
+        for (uint64_t word : m_words) {
+            if (word != 0) return true;
+        }
+        return false;
+    }
+
+    /**
+     * Call a function with the index of every set bit, in increasing order. The cost
+     * grows with the number of set bits, not with the number of properties.
+     */
+    template <typename Function>
+    void ForEachSet(Function&& function) const {
+        for (size_t i = 0; i < kWords; ++i) {
+            for (uint64_t word = m_words[i]; word != 0; word &= word - 1) {
+                function(i * 64 + std::countr_zero(word));
+            }
+        }
+    }
+
+    /**
+     * Write the first count bits as (count + 7) / 8 little-endian bytes
+     */
+    template <typename Serializer>
+    void Write(Serializer& serializer, size_t count) const {
+        uint8_t bytes[kWords * 8];
+        size_t byteCount = (count + 7) / 8;
+        for (size_t i = 0; i < byteCount; ++i) {
+            bytes[i] = static_cast<uint8_t>(m_words[i / 8] >> (i % 8 * 8));
+        }
+        serializer.WriteBytes(bytes, byteCount);
+    }
+
+    /**
+     * Read bits written by Write, bits at count and above are cleared
+     */
+    template <typename Deserializer>
+    void Read(Deserializer& deserializer, size_t count) {
+        uint8_t bytes[kWords * 8];
+        size_t byteCount = (count + 7) / 8;
+        deserializer.ReadBytes(bytes, byteCount);
+        Clear();
+        for (size_t i = 0; i < byteCount; ++i) {
+            m_words[i / 8] |= uint64_t(bytes[i]) << (i % 8 * 8);
+        }
+        for (size_t bit = count; bit < byteCount * 8; ++bit) {
+            Reset(bit);
+        }
+    }
+
+private:
+    static constexpr size_t kWords = Bits == 0 ? 1 : (Bits + 63) / 64;
+
+    uint64_t m_words[kWords] = {};
+};
+
+/**
+ * Whether a setter can skip assigning value, never for types without ==
+ */
+template <typename T>
+bool IsUnchanged(const T& current, const T& value) {
+    if constexpr (std::equality_comparable<T>) {
+        return current == value;
+    } else {
+        return false;
+    }
+}
+
+} // namespace ReflectionRuntime
@@ -0,0 +1,164 @@
+#pragma once
+
+#include "ReflectionRuntime/BaseCall.h"
+#include "ReflectionRuntime/Serialization.h"
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+namespace ReflectionRuntime {
+
+/**
+ * Stable 64-bit content hash. Bytes are consumed as little-endian 64-bit words with the
+ * block mixing of MurmurHash3 x64 (one lane), the last partial word is zero-padded and
+ * the total length is folded in before the fmix64 finalizer.
+ *
+ * The result depends only on the byte sequence, not on how it is split into WriteBytes
+ * calls, and it never changes between builds, runs or platforms, so it can be stored as
+ * a persistent cache key. Generated Hash functions feed it the bytes Write produces for
+ * the Save properties, i.e. the serialized form of the object without schema header.
+ */
+class Hasher {
+public:
+    explicit Hasher(uint64_t seed = 0) noexcept : m_state(seed) {}
+
+    void WriteBytes(const void* data, size_t size) noexcept {
+        // Empty vectors pass a null pointer, which memcpy must not see
+        if (size == 0) {
+            return;
+        }
+        const auto* bytes = static_cast<const uint8_t*>(data);
+        m_length += size;
+
+        if (m_pending > 0) {
+            size_t count = std::min(size, sizeof(m_buffer) - m_pending);
+            std::memcpy(m_buffer + m_pending, bytes, count);
+            m_pending += count;
+            bytes += count;
+            size -= count;
+            if (m_pending < sizeof(m_buffer)) {
+                return;
+            }
+            MixWord(LoadWord(m_buffer));
+            m_pending = 0;
+        }
+
+        for (; size >= sizeof(uint64_t); bytes += sizeof(uint64_t), size -= sizeof(uint64_t)) {
+            MixWord(LoadWord(bytes));
+        }
+        std::memcpy(m_buffer, bytes, size);
+        m_pending = size;
+    }
+
+    uint64_t Finish() const noexcept {
+        Hasher copy = *this;
+        if (copy.m_pending > 0) {
+            std::memset(copy.m_buffer + copy.m_pending, 0, sizeof(m_buffer) - copy.m_pending);
+            copy.MixWord(LoadWord(copy.m_buffer));
+        }
+
+        uint64_t hash = copy.m_state ^ copy.m_length;
+        hash ^= hash >> 33;
+        hash *= 0xFF51AFD7ED558CCDull;
+        hash ^= hash >> 33;
+        hash *= 0xC4CEB9FE1A85EC53ull;
+        hash ^= hash >> 33;
+        return hash;
+    }
+
+private:
+    static uint64_t LoadWord(const uint8_t* bytes) noexcept {
+        uint64_t word = 0;
+        std::memcpy(&word, bytes, sizeof(word));
+        if constexpr (std::endian::native == std::endian::big) {
+            word = ByteSwap(word);
+        }
+        return word;
+    }
+
+    void MixWord(uint64_t word) noexcept {
+        word *= 0x87C37B91114253D5ull;
+        word = std::rotl(word, 31);
+        word *= 0x4CF5AD432745937Full;
+        m_state ^= word;
+        m_state = std::rotl(m_state, 27) * 5 + 0x52DCE729;
+    }
+
+    uint64_t m_state = 0;
+    uint64_t m_length = 0;
+    uint8_t m_buffer[8] = {};
+    size_t m_pending = 0;
+};
+
+/**
+ * Values that are equal exactly when their bytes are, so runs of them are compared with
+ * memcmp. Floating point values count: generated Equals compares them bitwise, which
+ * keeps it consistent with Hash and lets NaN keys find themselves.
+ */
+template <typename T>
+inline constexpr bool IsBitwiseComparable =
+    IsBulkCopyable<T> &&
+    (std::has_unique_object_representations_v<T> || std::is_same_v<std::remove_all_extents_t<T>, float> ||
+     std::is_same_v<std::remove_all_extents_t<T>, double>);
+
+/**
+ * Feed a property to a hasher: reflected classes through their generated HashProperties,
+ * everything else as the bytes Write produces
+ */
+template <typename T>
+void AppendHash(Hasher& hasher, const T& value) {
+    if constexpr (requires { HashProperties(hasher, value); }) {
+        HashProperties(hasher, value);
+    } else {
+        Write(hasher, value);
+    }
+}
+
+/**
+ * Compare two property values the way Hash sees them: floating point values bitwise,
+ * reflected classes through their generated Equals, other classes Write copies as bytes
+ * by their bytes, everything else with ==
+ */
+template <typename T>
+bool EqualValues(const T& a, const T& b) {
+    if constexpr (std::is_same_v<T, float>) {
+        return std::bit_cast<uint32_t>(a) == std::bit_cast<uint32_t>(b);
+    } else if constexpr (std::is_same_v<T, double>) {
+        return std::bit_cast<uint64_t>(a) == std::bit_cast<uint64_t>(b);
+    } else if constexpr (requires { Equals(a, b); }) {
+        return Equals(a, b);
+    } else if constexpr (IsBitwiseComparable<T>) {
+        return std::memcmp(&a, &b, sizeof(T)) == 0;
+    } else if constexpr (std::is_array_v<T>) {
+        for (size_t i = 0; i < std::extent_v<T>; ++i) {
+            if (!EqualValues(a[i], b[i])) {
+                return false;
+            }
+        }
+        return true;
+    } else if constexpr (std::is_class_v<T> && kBulkCopy && IsBulkCopyable<T>) {
+        return std::memcmp(&a, &b, sizeof(T)) == 0;
+    } else if constexpr (IsVector<T>::value) {
+        using Element = typename T::value_type;
+        if (a.size() != b.size()) {
+            return false;
+        }
+        if constexpr (!std::is_same_v<Element, bool> && IsBitwiseComparable<Element>) {
+            return a.empty() || std::memcmp(a.data(), b.data(), a.size() * sizeof(Element)) == 0;
+        } else {
+            for (size_t i = 0; i < a.size(); ++i) {
+                if (!EqualValues<Element>(a[i], b[i])) {
+                    return false;
+                }
+            }
+            return true;
+        }
+    } else {
+        return a == b;
+    }
+}
+
+} // namespace ReflectionRuntime
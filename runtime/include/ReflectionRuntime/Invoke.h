@@ -0,0 +1,142 @@
+#pragma once
+
+#include <cstddef>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+namespace ReflectionRuntime {
+
+/**
+ * Type-erased call of a reflected function.
+ * @param object The object to call a member function on, ignored for static functions
+ * @param arguments One pointer per parameter, to a value of the parameter's type
+ * @param result Pointer to an object of the return type that the result is assigned
+ *               to, or to a pointer for functions returning a reference. May be null
+ *               to discard the result.
+ */
+using FunctionThunk = void (*)(void* object, void* const* arguments, void* result);
+
+template <typename Function>
+struct FunctionTraits;
+
+template <typename R, typename... Args>
+struct FunctionTraits<R (*)(Args...)> {
+    using Object = void;
+    using Result = R;
+    using Arguments = std::tuple<Args...>;
+};
+
+template <typename R, typename... Args>
+struct FunctionTraits<R (*)(Args...) noexcept> : FunctionTraits<R (*)(Args...)> {};
+
+template <typename C, typename R, typename... Args>
+struct FunctionTraits<R (C::*)(Args...)> {
+    using Object = C;
+    using Result = R;
+    using Arguments = std::tuple<Args...>;
+
+    // Rvalue-qualified functions are called on the object as an rvalue
+    static constexpr bool kRvalueObject = false;
+};
+
+template <typename C, typename R, typename... Args>
+struct FunctionTraits<R (C::*)(Args...) const> : FunctionTraits<R (C::*)(Args...)> {
+    using Object = const C;
+};
+
+template <typename C, typename R, typename... Args>
+struct FunctionTraits<R (C::*)(Args...) noexcept> : FunctionTraits<R (C::*)(Args...)> {};
+
+template <typename C, typename R, typename... Args>
+struct FunctionTraits<R (C::*)(Args...) const noexcept> : FunctionTraits<R (C::*)(Args...) const> {};
+
+template <typename C, typename R, typename... Args>
+struct FunctionTraits<R (C::*)(Args...) &> : FunctionTraits<R (C::*)(Args...)> {};
+
+template <typename C, typename R, typename... Args>
+struct FunctionTraits<R (C::*)(Args...) const &> : FunctionTraits<R (C::*)(Args...) const> {};
+
+template <typename C, typename R, typename... Args>
+struct FunctionTraits<R (C::*)(Args...) & noexcept> : FunctionTraits<R (C::*)(Args...)> {};
+
+template <typename C, typename R, typename... Args>
+struct FunctionTraits<R (C::*)(Args...) const & noexcept> : FunctionTraits<R (C::*)(Args...) const> {};
+
+template <typename C, typename R, typename... Args>
+struct FunctionTraits<R (C::*)(Args...) &&> : FunctionTraits<R (C::*)(Args...)> {
+    static constexpr bool kRvalueObject = true;
+};
+
+template <typename C, typename R, typename... Args>
+struct FunctionTraits<R (C::*)(Args...) const &&> : FunctionTraits<R (C::*)(Args...) const> {
+    static constexpr bool kRvalueObject = true;
+};
+
+template <typename C, typename R, typename... Args>
+struct FunctionTraits<R (C::*)(Args...) && noexcept> : FunctionTraits<R (C::*)(Args...) &&> {};
+
+template <typename C, typename R, typename... Args>
+struct FunctionTraits<R (C::*)(Args...) const && noexcept> : FunctionTraits<R (C::*)(Args...) const &&> {};
+
+/**
+ * Turn an argument pointer into the parameter: a reference to the value for reference
+ * parameters, the value itself otherwise. Rvalue reference parameters move from it.
+ */
+template <typename Parameter>
+decltype(auto) UnpackArgument(void* argument) noexcept {
+    using Value = std::remove_cvref_t<Parameter>;
+    if constexpr (std::is_rvalue_reference_v<Parameter>) {
+        return std::move(*static_cast<Value*>(argument));
+    } else {
+        return *static_cast<std::remove_reference_t<Parameter>*>(argument);
+    }
+}
+
+template <auto Function, size_t... I>
+void InvokeWithArguments(void* object, void* const* arguments, void* result, std::index_sequence<I...>) {
+    using Traits = FunctionTraits<decltype(Function)>;
+    using Result = typename Traits::Result;
+    using Arguments = typename Traits::Arguments;
+
+    auto call = [&]() -> Result {
+        if constexpr (std::is_void_v<typename Traits::Object>) {
+            return Function(UnpackArgument<std::tuple_element_t<I, Arguments>>(arguments[I])...);
+        } else if constexpr (Traits::kRvalueObject) {
+            auto* self = static_cast<typename Traits::Object*>(object);
+            return (std::move(*self).*Function)(UnpackArgument<std::tuple_element_t<I, Arguments>>(arguments[I])...);
+        } else {
+            auto* self = static_cast<typename Traits::Object*>(object);
+            return (self->*Function)(UnpackArgument<std::tuple_element_t<I, Arguments>>(arguments[I])...);
+        }
+    };
+
+    if constexpr (std::is_void_v<Result>) {
+        call();
+    } else if (result == nullptr) {
+        call();
+    } else if constexpr (std::is_reference_v<Result>) {
+        *static_cast<std::remove_reference_t<Result>**>(result) = &call();
+    } else {
+        *static_cast<Result*>(result) = call();
+    }
+}
+
+/**
+ * Thunk calling one function directly, generated per GFUNCTION. Arguments are used in
+ * place and the result is assigned to the caller's storage, so a call allocates
+ * nothing and the compiler can inline the function into the thunk.
+ */
+template <auto Function>
+void InvokeThunk(void* object, void* const* arguments, void* result) {
+    using Arguments = typename FunctionTraits<decltype(Function)>::Arguments;
+    InvokeWithArguments<Function>(object, arguments, result, std::make_index_sequence<std::tuple_size_v<Arguments>>{});
+}
+
+/**
+ * Number of parameters of a function
+ */
+template <auto Function>
+inline constexpr size_t kParameterCount = std::tuple_size_v<typename FunctionTraits<decltype(Function)>::Arguments>;
+
+} // namespace ReflectionRuntime
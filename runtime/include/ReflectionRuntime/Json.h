@@ -0,0 +1,540 @@
+#pragma once
+
+#include "ReflectionRuntime/BaseCall.h"
+#include "ReflectionRuntime/Serialization.h"
+#include <charconv>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <ostream>
+#include <string>
+#include <string_view>
+#include <type_traits>
+
+namespace ReflectionRuntime {
+
+/**
+ * Streaming JSON output. Text is appended to one reusable buffer; with a stream the
+ * buffer is handed over whenever it outgrows the flush threshold at the end of an
+ * object or array, so dumps of any size need a fixed amount of memory. Numbers are
+ * formatted with std::to_chars, floating point values in their shortest round-trip
+ * form. Generated WriteJson functions pass keys as precomputed "\"name\":" literals.
+ */
+class JsonWriter {
+public:
+    JsonWriter() = default;
+    explicit JsonWriter(std::ostream& stream, size_t flushThreshold = 64 * 1024)
+        : m_stream(&stream), m_flushThreshold(flushThreshold) {
+        m_buffer.reserve(flushThreshold + 4096);
+    }
+
+    JsonWriter(const JsonWriter&) = delete;
+    JsonWriter& operator=(const JsonWriter&) = delete;
+
+    ~JsonWriter() { Flush(); }
+
+    void BeginObject() {
+        Separate();
+        m_buffer.push_back('{');
+        m_needsComma = false;
+    }
+
+    void EndObject() {
+        m_buffer.push_back('}');
+        m_needsComma = true;
+        FlushIfFull();
+    }
+
+    void BeginArray() {
+        Separate();
+        m_buffer.push_back('[');
+        m_needsComma = false;
+    }
+
+    void EndArray() {
+        m_buffer.push_back(']');
+        m_needsComma = true;
+        FlushIfFull();
+    }
+
+    /**
+     * Start a member of the current object
+     * @param quotedKey The key in quotes followed by the colon, e.g. "\"health\":"
+     */
+    void Key(std::string_view quotedKey) {
+        if (m_needsComma) {
+            m_buffer.push_back(',');
+        }
+        m_buffer.append(quotedKey);
+        m_needsComma = false;
+    }
+
+    void Null() {
+        Separate();
+        m_buffer.append("null");
+    }
+
+    void Bool(bool value) {
+        Separate();
+        m_buffer.append(value ? "true" : "false");
+    }
+
+    /**
+     * Integer or floating point value. NaN and infinity have no JSON form and are
+     * written as null.
+     */
+    template <typename T>
+    void Number(T value) {
+        if constexpr (std::is_floating_point_v<T>) {
+            if (!std::isfinite(value)) {
+                Null();
+                return;
+            }
+        }
+        Separate();
+        char text[64];
+        auto result = std::to_chars(text, text + sizeof(text), value);
+        m_buffer.append(text, result.ptr);
+    }
+
+    void String(std::string_view value) {
+        Separate();
+        m_buffer.push_back('"');
+
+        // Copy the longest stretches that need no escaping in one go
+        size_t start = 0;
+        for (size_t i = 0; i < value.size(); ++i) {
+            auto c = static_cast<unsigned char>(value[i]);
+            if (c >= 0x20 && c != '"' && c != '\\') {
+                continue;
+            }
+            m_buffer.append(value.data() + start, i - start);
+            start = i + 1;
+            switch (c) {
+                case '"': m_buffer.append("\\\""); break;
+                case '\\': m_buffer.append("\\\\"); break;
+                case '\n': m_buffer.append("\\n"); break;
+                case '\r': m_buffer.append("\\r"); break;
+                case '\t': m_buffer.append("\\t"); break;
+                default: {
+                    static constexpr char kHex[] = "0123456789abcdef";
+                    char escape[] = {'\\', 'u', '0', '0', kHex[c >> 4], kHex[c & 0xF]};
+                    m_buffer.append(escape, sizeof(escape));
+                    break;
+                }
+            }
+        }
+        m_buffer.append(value.data() + start, value.size() - start);
+        m_buffer.push_back('"');
+    }
+
+    /**
+     * Text written so far and not yet flushed to the stream
+     */
+    std::string_view GetText() const noexcept { return m_buffer; }
+
+    void Flush() {
+        if (m_stream && !m_buffer.empty()) {
+            m_stream->write(m_buffer.data(), static_cast<std::streamsize>(m_buffer.size()));
+            m_buffer.clear();
+        }
+    }
+
+private:
+    void Separate() {
+        if (m_needsComma) {
+            m_buffer.push_back(',');
+        }
+        m_needsComma = true;
+    }
+
+    void FlushIfFull() {
+        if (m_stream && m_buffer.size() >= m_flushThreshold) {
+            Flush();
+        }
+    }
+
+    std::string m_buffer;
+    std::ostream* m_stream = nullptr;
+    size_t m_flushThreshold = 0;
+    bool m_needsComma = false;
+};
+
+/**
+ * Pull parser over JSON text. Values are parsed straight into their destination, with
+ * std::from_chars for numbers; nothing is collected into a tree. Keys and strings
+ * without escapes are views into the text. Malformed input makes IsValid return false
+ * and ends every loop, so the result is checked once at the end.
+ */
+class JsonReader {
+public:
+    explicit JsonReader(std::string_view text) noexcept
+        : m_position(text.data()), m_end(text.data() + text.size()) {}
+
+    bool BeginObject() {
+        m_afterOpen = true;
+        return Expect('{');
+    }
+
+    /**
+     * Move to the next member of the current object
+     * @param key Receives the key, valid until the next call on the reader
+     * @return False after the closing brace or on an error
+     */
+    bool NextKey(std::string_view& key) {
+        if (!Next('}')) {
+            return false;
+        }
+        SkipWhitespace();
+        return ParseString(key) && Expect(':');
+    }
+
+    bool BeginArray() {
+        m_afterOpen = true;
+        return Expect('[');
+    }
+
+    /**
+     * Move to the next element of the current array
+     * @return False after the closing bracket or on an error
+     */
+    bool NextElement() {
+        return Next(']');
+    }
+
+    bool ReadBool(bool& value) {
+        SkipWhitespace();
+        if (Consume("true")) {
+            value = true;
+        } else if (Consume("false")) {
+            value = false;
+        } else {
+            return Fail();
+        }
+        return true;
+    }
+
+    /**
+     * Read a number. null reads as NaN into floating point values, the form JsonWriter
+     * gives NaN and infinity.
+     */
+    template <typename T>
+    bool ReadNumber(T& value) {
+        SkipWhitespace();
+        if constexpr (std::is_floating_point_v<T>) {
+            if (Consume("null")) {
+                value = std::numeric_limits<T>::quiet_NaN();
+                return true;
+            }
+        }
+        auto result = std::from_chars(m_position, m_end, value);
+        if (result.ec != std::errc{}) {
+            return Fail();
+        }
+        m_position = result.ptr;
+        return true;
+    }
+
+    /**
+     * Read a string
+     * @param value Receives the string, valid until the next call on the reader
+     */
+    bool ReadString(std::string_view& value) {
+        SkipWhitespace();
+        return ParseString(value);
+    }
+
+    /**
+     * Skip one value of any kind, e.g. the value of a key the class does not know.
+     * Values nested deeper than kMaxSkipDepth are an error rather than a stack overflow.
+     */
+    bool SkipValue() {
+        return SkipValue(0);
+    }
+
+    bool IsValid() const noexcept { return !m_error; }
+
+    static constexpr unsigned kMaxSkipDepth = 256;
+
+private:
+    bool SkipValue(unsigned depth) {
+        if (depth == kMaxSkipDepth) {
+            return Fail();
+        }
+        SkipWhitespace();
+        if (m_position == m_end) {
+            return Fail();
+        }
+        switch (*m_position) {
+            case '"': {
+                std::string_view ignored;
+                return ParseString(ignored);
+            }
+            case '{': {
+                std::string_view key;
+                BeginObject();
+                while (NextKey(key)) {
+                    SkipValue(depth + 1);
+                }
+                return IsValid();
+            }
+            case '[':
+                BeginArray();
+                while (NextElement()) {
+                    SkipValue(depth + 1);
+                }
+                return IsValid();
+            case 't':
+            case 'f': {
+                bool ignored;
+                return ReadBool(ignored);
+            }
+            case 'n':
+                return Consume("null") || Fail();
+            default: {
+                double ignored;
+                return ReadNumber(ignored);
+            }
+        }
+    }
+
+    void SkipWhitespace() noexcept {
+        while (m_position != m_end && (*m_position == ' ' || *m_position == '\n' ||
+                                       *m_position == '\r' || *m_position == '\t')) {
+            ++m_position;
+        }
+    }
+
+    bool Consume(std::string_view token) noexcept {
+        if (static_cast<size_t>(m_end - m_position) < token.size() ||
+            std::string_view(m_position, token.size()) != token) {
+            return false;
+        }
+        m_position += token.size();
+        return true;
+    }
+
+    bool Expect(char c) {
+        SkipWhitespace();
+        if (m_position == m_end || *m_position != c) {
+            return Fail();
+        }
+        ++m_position;
+        return true;
+    }
+
+    /**
+     * Shared by objects and arrays: a member follows the opening character or a comma
+     */
+    bool Next(char close) {
+        if (m_error) {
+            return false;
+        }
+        SkipWhitespace();
+        if (m_position != m_end && *m_position == close) {
+            ++m_position;
+            m_afterOpen = false;
+            return false;
+        }
+        if (!m_afterOpen && !Expect(',')) {
+            return false;
+        }
+        m_afterOpen = false;
+        return true;
+    }
+
+    bool ParseString(std::string_view& value) {
+        if (m_position == m_end || *m_position != '"') {
+            return Fail();
+        }
+        const char* start = ++m_position;
+        while (m_position != m_end && *m_position != '"' && *m_position != '\\') {
+            ++m_position;
+        }
+        if (m_position == m_end) {
+            return Fail();
+        }
+        if (*m_position == '"') {
+            value = std::string_view(start, static_cast<size_t>(m_position - start));
+            ++m_position;
+            return true;
+        }
+
+        // Escapes need a decoded copy
+        m_scratch.assign(start, m_position);
+        while (m_position != m_end && *m_position != '"') {
+            if (*m_position != '\\') {
+                m_scratch.push_back(*m_position++);
+                continue;
+            }
+            if (++m_position == m_end) {
+                return Fail();
+            }
+            switch (*m_position++) {
+                case '"': m_scratch.push_back('"'); break;
+                case '\\': m_scratch.push_back('\\'); break;
+                case '/': m_scratch.push_back('/'); break;
+                case 'b': m_scratch.push_back('\b'); break;
+                case 'f': m_scratch.push_back('\f'); break;
+                case 'n': m_scratch.push_back('\n'); break;
+                case 'r': m_scratch.push_back('\r'); break;
+                case 't': m_scratch.push_back('\t'); break;
+                case 'u': {
+                    uint32_t codePoint = 0;
+                    if (!ParseHex(codePoint)) {
+                        return Fail();
+                    }
+                    if (codePoint >= 0xD800 && codePoint < 0xDC00) {
+                        uint32_t low = 0;
+                        if (!Consume("\\u") || !ParseHex(low) || low < 0xDC00 || low >= 0xE000) {
+                            return Fail();
+                        }
+                        codePoint = 0x10000 + ((codePoint - 0xD800) << 10) + (low - 0xDC00);
+                    }
+                    AppendUtf8(codePoint);
+                    break;
+                }
+                default:
+                    return Fail();
+            }
+        }
+        if (m_position == m_end) {
+            return Fail();
+        }
+        ++m_position;
+        value = m_scratch;
+        return true;
+    }
+
+    bool ParseHex(uint32_t& value) {
+        if (m_end - m_position < 4) {
+            return false;
+        }
+        auto result = std::from_chars(m_position, m_position + 4, value, 16);
+        if (result.ec != std::errc{} || result.ptr != m_position + 4) {
+            return false;
+        }
+        m_position += 4;
+        return true;
+    }
+
+    void AppendUtf8(uint32_t codePoint) {
+        if (codePoint < 0x80) {
+            m_scratch.push_back(static_cast<char>(codePoint));
+        } else if (codePoint < 0x800) {
+            m_scratch.push_back(static_cast<char>(0xC0 | (codePoint >> 6)));
+            m_scratch.push_back(static_cast<char>(0x80 | (codePoint & 0x3F)));
+        } else if (codePoint < 0x10000) {
+            m_scratch.push_back(static_cast<char>(0xE0 | (codePoint >> 12)));
+            m_scratch.push_back(static_cast<char>(0x80 | ((codePoint >> 6) & 0x3F)));
+            m_scratch.push_back(static_cast<char>(0x80 | (codePoint & 0x3F)));
+        } else {
+            m_scratch.push_back(static_cast<char>(0xF0 | (codePoint >> 18)));
+            m_scratch.push_back(static_cast<char>(0x80 | ((codePoint >> 12) & 0x3F)));
+            m_scratch.push_back(static_cast<char>(0x80 | ((codePoint >> 6) & 0x3F)));
+            m_scratch.push_back(static_cast<char>(0x80 | (codePoint & 0x3F)));
+        }
+    }
+
+    bool Fail() noexcept {
+        m_error = true;
+        m_position = m_end;
+        return false;
+    }
+
+    const char* m_position;
+    const char* m_end;
+    std::string m_scratch;
+    bool m_afterOpen = false;
+    bool m_error = false;
+};
+
+/**
+ * Write a property value: numbers, bools, enums as their underlying value, strings,
+ * vectors and arrays as JSON arrays, reflected classes through their generated WriteJson
+ */
+template <typename T>
+void WriteJsonValue(JsonWriter& writer, const T& value) {
+    if constexpr (std::is_same_v<T, bool>) {
+        writer.Bool(value);
+    } else if constexpr (std::is_enum_v<T>) {
+        writer.Number(static_cast<std::underlying_type_t<T>>(value));
+    } else if constexpr (std::is_arithmetic_v<T>) {
+        writer.Number(value);
+    } else if constexpr (std::is_convertible_v<const T&, std::string_view>) {
+        writer.String(value);
+    } else if constexpr (IsVector<T>::value || std::is_array_v<T>) {
+        writer.BeginArray();
+        if constexpr (std::is_same_v<T, std::vector<bool>>) {
+            for (bool element : value) {
+                writer.Bool(element);
+            }
+        } else {
+            for (const auto& element : value) {
+                WriteJsonValue(writer, element);
+            }
+        }
+        writer.EndArray();
+    } else if constexpr (requires { WriteJson(writer, value); }) {
+        WriteJson(writer, value);
+    } else {
+        static_assert(kAlwaysFalse<T>, "No JSON form for this property type");
+    }
+}
+
+/**
+ * Read a value written by WriteJsonValue. Array elements beyond the size of a fixed
+ * array are skipped, missing ones keep their value.
+ */
+template <typename T>
+bool ReadJsonValue(JsonReader& reader, T& value) {
+    if constexpr (std::is_same_v<T, bool>) {
+        return reader.ReadBool(value);
+    } else if constexpr (std::is_enum_v<T>) {
+        std::underlying_type_t<T> underlying{};
+        if (!reader.ReadNumber(underlying)) {
+            return false;
+        }
+        value = static_cast<T>(underlying);
+        return true;
+    } else if constexpr (std::is_arithmetic_v<T>) {
+        return reader.ReadNumber(value);
+    } else if constexpr (std::is_same_v<T, std::string>) {
+        std::string_view text;
+        if (!reader.ReadString(text)) {
+            return false;
+        }
+        value.assign(text);
+        return true;
+    } else if constexpr (IsVector<T>::value) {
+        value.clear();
+        if (!reader.BeginArray()) {
+            return false;
+        }
+        while (reader.NextElement()) {
+            typename T::value_type element{};
+            ReadJsonValue(reader, element);
+            value.push_back(std::move(element));
+        }
+        return reader.IsValid();
+    } else if constexpr (std::is_array_v<T>) {
+        if (!reader.BeginArray()) {
+            return false;
+        }
+        for (size_t i = 0; reader.NextElement(); ++i) {
+            if (i < std::extent_v<T>) {
+                ReadJsonValue(reader, value[i]);
+            } else {
+                reader.SkipValue();
+            }
+        }
+        return reader.IsValid();
+    } else if constexpr (requires { ReadJson(reader, value); }) {
+        return ReadJson(reader, value);
+    } else {
+        static_assert(kAlwaysFalse<T>, "No JSON form for this property type");
+    }
+}
+
+} // namespace ReflectionRuntime
@@ -0,0 +1,43 @@
+#pragma once
+
+#include <cstdint>
+#include <string_view>
+
+namespace ReflectionRuntime {
+
+/**
+ * 64-bit FNV-1a hash of a name.
+ * The value is stable across compilers, platforms and runs and can be computed at
+ * compile time, so it is used for type ids and can be persisted.
+ */
+constexpr uint64_t HashName(std::string_view name) noexcept {
+    uint64_t hash = 14695981039346656037ull;
+    for (char c : name) {
+        hash ^= static_cast<uint8_t>(c);
+        hash *= 1099511628211ull;
+    }
+    return hash;
+}
+
+/**
+ * Seeded variant of HashName used by the generated perfect hash tables.
+ * The generator builds the tables with this exact function, so it must not change
+ * without regenerating all code.
+ */
+constexpr uint64_t HashName(std::string_view name, uint64_t seed) noexcept {
+    uint64_t hash = 14695981039346656037ull ^ (seed * 0x9E3779B97F4A7C15ull);
+    for (char c : name) {
+        hash ^= static_cast<uint8_t>(c);
+        hash *= 1099511628211ull;
+    }
+
+    // Finalizer, so the low bits used for the modulo depend on every input byte
+    hash ^= hash >> 33;
+    hash *= 0xFF51AFD7ED558CCDull;
+    hash ^= hash >> 33;
+    hash *= 0xC4CEB9FE1A85EC53ull;
+    hash ^= hash >> 33;
+    return hash;
+}
+
+} // namespace ReflectionRuntime
@@ -0,0 +1,64 @@
+#pragma once
+
+#include "ReflectionRuntime/NameHash.h"
+#include <cstdint>
+#include <span>
+#include <string_view>
+
+namespace ReflectionRuntime {
+
+/**
+ * Minimal perfect hash from member names to their declaration index.
+ *
+ * The generator builds one per class with hash-and-displace: the first hash picks a
+ * bucket, the bucket's displacement either names a slot directly (negative values,
+ * -slot - 1) or is the seed of a second hash that spreads the bucket's names over
+ * free slots. A lookup is two hashes and one string compare, never allocates, and
+ * rejects names that are not members. Without displacements the names are searched
+ * linearly, which the generator falls back to if it cannot build a table.
+ */
+struct NameIndex {
+    static constexpr int kNotFound = -1;
+
+    std::span<const int32_t> displacements;
+
+    // Indexed by slot
+    std::span<const std::string_view> names;
+    std::span<const uint16_t> indices;
+
+    /**
+     * Find the declaration index of a name
+     * @return Index of the member, kNotFound if there is none with that name
+     */
+    constexpr int Find(std::string_view name) const noexcept {
+        if (names.empty()) {
+            return kNotFound;
+        }
+        if (displacements.empty()) {
+            for (size_t i = 0; i < names.size(); ++i) {
+                if (names[i] == name) return indices[i];
+            }
+            return kNotFound;
+        }
+        const uint64_t count = names.size();
+        const int32_t displacement = displacements[HashName(name, 0) % count];
+        const size_t slot = displacement < 0
+            ? static_cast<size_t>(-displacement - 1)
+            : static_cast<size_t>(HashName(name, static_cast<uint64_t>(displacement)) % count);
+        return names[slot] == name ? indices[slot] : kNotFound;
+    }
+};
+
+/**
+ * Hand the name indices of a class to its runtime type, if the engine's type takes them
+ * with SetNameIndex. Other engines keep their own lookup and can call the generated
+ * Find<Class>PropertyIndex and Find<Class>FunctionIndex functions instead.
+ */
+template <typename Type>
+void AttachNameIndex(Type& type, const NameIndex& properties, const NameIndex& functions) {
+    if constexpr (requires { type.SetNameIndex(properties, functions); }) {
+        type.SetNameIndex(properties, functions);
+    }
+}
+
+} // namespace ReflectionRuntime
@@ -0,0 +1,123 @@
+#pragma once
+
+#include "ReflectionRuntime/BaseCall.h"
+#include "ReflectionRuntime/Serialization.h"
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <span>
+#include <vector>
+
+namespace ReflectionRuntime {
+
+class PropertyPatch;
+class PatchReader;
+
+template <typename T>
+void AppendPatchValue(PropertyPatch& patch, const T& value);
+
+/**
+ * Changed properties of an object: for each one its property index and its new value
+ * in the binary format. A patch costs as much as the values that changed, whatever the
+ * size of the object. Indices are those of the generated <Class>PropertyIndex, after
+ * the ones of the base classes, so patches are meant for the build that made them, e.g.
+ * an undo history or the revisions of an asset open in the editor.
+ */
+class PropertyPatch {
+public:
+    template <typename T>
+    void Add(uint16_t index, const T& value) {
+        Write(*this, index);
+        AppendPatchValue(*this, value);
+        ++m_changeCount;
+    }
+
+    /**
+     * Serializer interface used by Add
+     */
+    void WriteBytes(const void* data, size_t size) {
+        const auto* bytes = static_cast<const uint8_t*>(data);
+        m_bytes.insert(m_bytes.end(), bytes, bytes + size);
+    }
+
+    uint32_t GetChangeCount() const noexcept { return m_changeCount; }
+    bool IsEmpty() const noexcept { return m_changeCount == 0; }
+    std::span<const uint8_t> GetBytes() const noexcept { return m_bytes; }
+
+    void Clear() noexcept {
+        m_bytes.clear();
+        m_changeCount = 0;
+    }
+
+private:
+    std::vector<uint8_t> m_bytes;
+    uint32_t m_changeCount = 0;
+};
+
+/**
+ * Reads the entries of a PropertyPatch. Reading past the end makes IsValid return false.
+ */
+class PatchReader {
+public:
+    explicit PatchReader(const PropertyPatch& patch) noexcept : m_bytes(patch.GetBytes()) {}
+
+    /**
+     * Move to the next entry, its value is read next
+     * @return False at the end of the patch
+     */
+    bool Next(uint16_t& index) {
+        if (m_position == m_bytes.size()) {
+            return false;
+        }
+        Read(*this, index);
+        return IsValid();
+    }
+
+    /**
+     * Deserializer interface used for the values
+     */
+    void ReadBytes(void* data, size_t size) {
+        if (size > m_bytes.size() - m_position) {
+            std::memset(data, 0, size);
+            m_position = m_bytes.size();
+            m_overrun = true;
+            return;
+        }
+        std::memcpy(data, m_bytes.data() + m_position, size);
+        m_position += size;
+    }
+
+    bool IsValid() const noexcept { return !m_overrun; }
+
+private:
+    std::span<const uint8_t> m_bytes;
+    size_t m_position = 0;
+    bool m_overrun = false;
+};
+
+/**
+ * Write a property value into a patch: reflected classes through their generated
+ * WritePatchProperties, everything else as the bytes Write produces
+ */
+template <typename T>
+void AppendPatchValue(PropertyPatch& patch, const T& value) {
+    if constexpr (requires { WritePatchProperties(patch, value); }) {
+        WritePatchProperties(patch, value);
+    } else {
+        Write(patch, value);
+    }
+}
+
+/**
+ * Read a value written by AppendPatchValue
+ */
+template <typename T>
+void ReadPatchValue(PatchReader& reader, T& value) {
+    if constexpr (requires { ReadPatchProperties(reader, value); }) {
+        ReadPatchProperties(reader, value);
+    } else {
+        Read(reader, value);
+    }
+}
+
+} // namespace ReflectionRuntime
@@ -0,0 +1,266 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <new>
+#include <utility>
+#include <vector>
+
+namespace ReflectionRuntime {
+
+/**
+ * Allocation counters of one pooled type. Updated with relaxed atomics, so they are
+ * cheap to maintain and exact once the allocating threads are quiet. All of them only
+ * grow, except reservedBytes, the size of the chunks currently held.
+ */
+struct AllocationStats {
+    std::atomic<uint64_t> allocations{0};
+    std::atomic<uint64_t> frees{0};
+    std::atomic<uint64_t> chunks{0};
+    std::atomic<uint64_t> reservedBytes{0};
+    std::atomic<uint64_t> resets{0};
+
+    uint64_t GetLiveObjects() const noexcept {
+        return allocations.load(std::memory_order_relaxed) - frees.load(std::memory_order_relaxed);
+    }
+};
+
+/**
+ * Per-type allocator behind the factories of GCLASS(Pooled) and GCLASS(Arena) classes.
+ *
+ * Memory comes from large chunks shared by all threads. Each thread carves slots from
+ * its own current chunk and keeps its own free list, so allocation and deallocation
+ * take no lock; only fetching a new chunk or moving a batch of free slots between a
+ * thread and the shared free list does. A thread that frees more than it allocates,
+ * or exits, hands its free slots to the shared list, where other threads find them
+ * before fetching a chunk. A pool reuses freed slots, an arena (Reuse = false) never
+ * does and gives its memory back in one step with Reset.
+ */
+template <typename T, bool Reuse = true>
+class ObjectPool {
+public:
+    static void* Allocate() {
+        ThreadCache& cache = GetThreadCache();
+        GetStats().allocations.fetch_add(1, std::memory_order_relaxed);
+
+        if constexpr (Reuse) {
+            if (!cache.freeList && cache.cursor == cache.end) {
+                TakeSharedSlots(cache);
+            }
+            if (cache.freeList) {
+                FreeSlot* slot = cache.freeList;
+                cache.freeList = slot->next;
+                --cache.freeCount;
+                return slot;
+            }
+        }
+        if (cache.cursor == cache.end) {
+            AllocateChunk(cache);
+        }
+        void* slot = cache.cursor;
+        cache.cursor += kSlotSize;
+        return slot;
+    }
+
+    /**
+     * Return the memory of an object whose destructor has already run
+     */
+    static void Free(void* memory) noexcept {
+        GetStats().frees.fetch_add(1, std::memory_order_relaxed);
+        if constexpr (Reuse) {
+            ThreadCache& cache = GetThreadCache();
+            auto* slot = static_cast<FreeSlot*>(memory);
+            slot->next = cache.freeList;
+            cache.freeList = slot;
+            if (++cache.freeCount >= 2 * kTransferBatch) {
+                GiveSharedSlots(cache, kTransferBatch);
+            }
+        }
+    }
+
+    /**
+     * Release every chunk at once, for level unloads and other bulk teardown. Objects
+     * still alive would be left in released memory, so nothing happens while there are
+     * any. Must not run concurrently with Allocate.
+     * @return False if objects of the type are still alive
+     */
+    static bool Reset() {
+        std::lock_guard<std::mutex> lock(GetShared().mutex);
+        if (GetStats().GetLiveObjects() != 0) {
+            return false;
+        }
+        for (std::byte* chunk : GetShared().chunks) {
+            ::operator delete(chunk, std::align_val_t{kSlotAlignment});
+        }
+        GetShared().chunks.clear();
+        GetShared().freeList = nullptr;
+        GetShared().freeCount = 0;
+        GetShared().generation.fetch_add(1, std::memory_order_release);
+
+        AllocationStats& stats = GetStats();
+        stats.reservedBytes.store(0, std::memory_order_relaxed);
+        stats.resets.fetch_add(1, std::memory_order_relaxed);
+        return true;
+    }
+
+    static AllocationStats& GetStats() noexcept {
+        static AllocationStats stats;
+        return stats;
+    }
+
+private:
+    struct FreeSlot {
+        FreeSlot* next;
+    };
+
+    static constexpr size_t kSlotAlignment = std::max(alignof(T), alignof(FreeSlot));
+    static constexpr size_t kSlotSize = (std::max(sizeof(T), sizeof(FreeSlot)) + kSlotAlignment - 1) /
+                                        kSlotAlignment * kSlotAlignment;
+    static constexpr size_t kSlotsPerChunk = std::max<size_t>(64, (64 * 1024) / kSlotSize);
+
+    // Free slots moved between a thread and the shared list at a time
+    static constexpr size_t kTransferBatch = kSlotsPerChunk / 2;
+
+    struct Shared {
+        std::mutex mutex;
+        std::vector<std::byte*> chunks;
+        FreeSlot* freeList = nullptr;
+        size_t freeCount = 0;
+        std::atomic<uint64_t> generation{0};
+    };
+
+    struct ThreadCache {
+        FreeSlot* freeList = nullptr;
+        size_t freeCount = 0;
+        std::byte* cursor = nullptr;
+        std::byte* end = nullptr;
+        uint64_t generation = 0;
+
+        // Slots of an exiting thread would be lost, other threads get them
+        ~ThreadCache() {
+            if constexpr (Reuse) {
+                if (generation != GetShared().generation.load(std::memory_order_acquire)) {
+                    return;
+                }
+                for (; cursor != end; cursor += kSlotSize) {
+                    auto* slot = reinterpret_cast<FreeSlot*>(cursor);
+                    slot->next = freeList;
+                    freeList = slot;
+                    ++freeCount;
+                }
+                GiveSharedSlots(*this, freeCount);
+            }
+        }
+    };
+
+    static Shared& GetShared() noexcept {
+        static Shared shared;
+        return shared;
+    }
+
+    static ThreadCache& GetThreadCache() noexcept {
+        thread_local ThreadCache cache;
+
+        // Slots cached before a Reset point into released chunks
+        uint64_t generation = GetShared().generation.load(std::memory_order_acquire);
+        if (cache.generation != generation) {
+            cache.freeList = nullptr;
+            cache.freeCount = 0;
+            cache.cursor = nullptr;
+            cache.end = nullptr;
+            cache.generation = generation;
+        }
+        return cache;
+    }
+
+    /**
+     * Move count slots from the front of a thread's free list to the shared one
+     */
+    static void GiveSharedSlots(ThreadCache& cache, size_t count) {
+        if (count == 0) {
+            return;
+        }
+        FreeSlot* first = cache.freeList;
+        FreeSlot* last = first;
+        for (size_t i = 1; i < count; ++i) {
+            last = last->next;
+        }
+        cache.freeList = last->next;
+        cache.freeCount -= count;
+
+        std::lock_guard<std::mutex> lock(GetShared().mutex);
+        last->next = GetShared().freeList;
+        GetShared().freeList = first;
+        GetShared().freeCount += count;
+    }
+
+    /**
+     * Refill an empty thread free list with up to kTransferBatch shared slots
+     */
+    static void TakeSharedSlots(ThreadCache& cache) {
+        std::lock_guard<std::mutex> lock(GetShared().mutex);
+        Shared& shared = GetShared();
+        size_t count = std::min(shared.freeCount, kTransferBatch);
+        if (count == 0) {
+            return;
+        }
+        FreeSlot* first = shared.freeList;
+        FreeSlot* last = first;
+        for (size_t i = 1; i < count; ++i) {
+            last = last->next;
+        }
+        shared.freeList = last->next;
+        shared.freeCount -= count;
+        last->next = nullptr;
+        cache.freeList = first;
+        cache.freeCount = count;
+    }
+
+    static void AllocateChunk(ThreadCache& cache) {
+        size_t bytes = kSlotSize * kSlotsPerChunk;
+        auto* chunk = static_cast<std::byte*>(::operator new(bytes, std::align_val_t{kSlotAlignment}));
+        {
+            std::lock_guard<std::mutex> lock(GetShared().mutex);
+            GetShared().chunks.push_back(chunk);
+        }
+        cache.cursor = chunk;
+        cache.end = chunk + bytes;
+
+        AllocationStats& stats = GetStats();
+        stats.chunks.fetch_add(1, std::memory_order_relaxed);
+        stats.reservedBytes.fetch_add(bytes, std::memory_order_relaxed);
+    }
+};
+
+/**
+ * Deleter of the unique_ptr returned by generated factories of pooled classes. It is
+ * empty, so the pointer stays the size of a raw pointer. Keep pooled objects in this
+ * pointer type: converting to a std::unique_ptr with the default deleter would free
+ * pool memory with delete.
+ */
+template <typename T, bool Reuse = true>
+struct PoolDeleter {
+    void operator()(T* object) const noexcept {
+        object->~T();
+        ObjectPool<T, Reuse>::Free(object);
+    }
+};
+
+/**
+ * Construct an object in its type's pool
+ */
+template <typename T, bool Reuse = true, typename... Args>
+T* CreatePooled(Args&&... args) {
+    void* memory = ObjectPool<T, Reuse>::Allocate();
+    try {
+        return new (memory) T(std::forward<Args>(args)...);
+    } catch (...) {
+        ObjectPool<T, Reuse>::Free(memory);
+        throw;
+    }
+}
+
+} // namespace ReflectionRuntime
@@ -0,0 +1,90 @@
+#pragma once
+
+#include "ReflectionRuntime/BaseCall.h"
+#include "ReflectionRuntime/TypeDescriptor.h"
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+namespace ReflectionRuntime {
+
+template <typename MemberPointer>
+struct MemberPointerTraits;
+
+template <typename C, typename T>
+struct MemberPointerTraits<T C::*> {
+    using Class = C;
+    using Type = T;
+};
+
+/**
+ * Compile-time description of one reflected property. Every property has its own type,
+ * so code working on it is instantiated for the exact member.
+ */
+template <auto Member, uint32_t Flags>
+struct PropertyField {
+    using Class = typename MemberPointerTraits<decltype(Member)>::Class;
+    using Type = typename MemberPointerTraits<decltype(Member)>::Type;
+
+    static constexpr auto kMember = Member;
+    static constexpr uint32_t kFlags = Flags;
+
+    std::string_view name;
+
+    static constexpr bool HasFlag(uint32_t flag) noexcept { return (Flags & flag) != 0; }
+
+    static constexpr Type& Get(Class& object) noexcept { return object.*Member; }
+    static constexpr const Type& Get(const Class& object) noexcept { return object.*Member; }
+};
+
+/**
+ * Tuple of the PropertyField of every reflected property of T, in declaration order.
+ * The generator defines GetReflectedProperties next to each class, found by ADL.
+ */
+template <typename T>
+inline constexpr auto kReflectedProperties = GetReflectedProperties(static_cast<const T*>(nullptr));
+
+template <uint32_t RequiredFlags, typename Object, typename Function, size_t... I>
+constexpr void ForEachPropertyImpl(Object& object, Function& function, std::index_sequence<I...>) {
+    const auto& properties = kReflectedProperties<std::remove_const_t<Object>>;
+    auto visit = [&]<size_t Index>(std::integral_constant<size_t, Index>) {
+        using Field = std::remove_cvref_t<decltype(std::get<Index>(properties))>;
+        if constexpr ((Field::kFlags & RequiredFlags) == RequiredFlags) {
+            function(std::get<Index>(properties), Field::Get(object));
+        }
+    };
+    (visit(std::integral_constant<size_t, I>{}), ...);
+}
+
+/**
+ * Call function(field, value) for every reflected property of an object that has all
+ * of RequiredFlags. The loop is unrolled at compile time and each call sees the
+ * property's real type, so the result is the same code as writing it out by hand.
+ *
+ *     ForEachProperty<PropertyFlags::Save>(player, [&](const auto& field, const auto& value) {
+ *         hash = HashCombine(hash, value);
+ *     });
+ */
+template <uint32_t RequiredFlags, typename Object, typename Function>
+constexpr void ForEachProperty(Object& object, Function&& function) {
+    using Properties = std::remove_cvref_t<decltype(kReflectedProperties<std::remove_const_t<Object>>)>;
+    ForEachPropertyImpl<RequiredFlags>(object, function, std::make_index_sequence<std::tuple_size_v<Properties>>{});
+}
+
+template <typename Object, typename Function>
+constexpr void ForEachProperty(Object& object, Function&& function) {
+    ForEachProperty<PropertyFlags::None>(object, function);
+}
+
+/**
+ * Call function(field) for every reflected property of T, without an object
+ */
+template <typename T, typename Function>
+constexpr void ForEachPropertyField(Function&& function) {
+    std::apply([&](const auto&... fields) { (function(fields), ...); }, kReflectedProperties<T>);
+}
+
+} // namespace ReflectionRuntime
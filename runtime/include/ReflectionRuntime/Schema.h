@@ -0,0 +1,193 @@
+#pragma once
+
+#include "ReflectionRuntime/NameHash.h"
+#include "ReflectionRuntime/Serialization.h"
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+namespace ReflectionRuntime {
+
+/**
+ * One serialized property of a class schema, identified by the hashes of its name and
+ * of its type as the generator spelled it
+ */
+struct SchemaField {
+    uint64_t nameHash = 0;
+    uint64_t typeHash = 0;
+};
+
+/**
+ * A field as recorded in a field table: its identity and its size in bytes
+ */
+struct SchemaEntry {
+    uint64_t nameHash = 0;
+    uint64_t typeHash = 0;
+    uint32_t size = 0;
+};
+
+/**
+ * Bytes of one entry of the field table in serialized data
+ */
+inline constexpr size_t kSchemaEntryBytes = 2 * sizeof(uint64_t) + sizeof(uint32_t);
+
+/**
+ * Size of a field table entry whose value only the engine's serializer can measure. The
+ * field can be read into a matching property, but not skipped.
+ */
+inline constexpr uint32_t kUnknownFieldSize = UINT32_MAX;
+
+/**
+ * Set in the stored fingerprint when a field table follows it. Fingerprints themselves
+ * always have this bit clear.
+ */
+inline constexpr uint64_t kSchemaTableBit = 1;
+
+/**
+ * Hash of the names, types and order of the serialized properties and of the class
+ * version. Bumping GCLASS(Version=N) changes it even if the fields stay the same.
+ */
+constexpr uint64_t SchemaFingerprint(std::span<const SchemaField> fields, uint32_t version) noexcept {
+    uint64_t fingerprint = HashName("", version);
+    for (const auto& field : fields) {
+        fingerprint = (fingerprint ^ field.nameHash) * 1099511628211ull;
+        fingerprint = (fingerprint ^ field.typeHash) * 1099511628211ull;
+    }
+    return fingerprint & ~kSchemaTableBit;
+}
+
+/**
+ * Skip bytes of serialized data, with the deserializer's own Skip if it has one
+ */
+template <typename Deserializer>
+void SkipBytes(Deserializer& deserializer, size_t size) {
+    if constexpr (requires { deserializer.Skip(size); }) {
+        deserializer.Skip(size);
+    } else {
+        std::byte scratch[256];
+        while (size > 0) {
+            size_t count = std::min(size, sizeof(scratch));
+            deserializer.ReadBytes(scratch, count);
+            size -= count;
+        }
+    }
+}
+
+/**
+ * Write the schema header of a class without field table: its fingerprint and the bytes
+ * of the properties that follow, kUnknownFieldSize if those cannot be measured
+ */
+template <typename Serializer>
+void WriteSchemaHeader(Serializer& serializer, uint64_t fingerprint, uint32_t payloadSize) {
+    Write(serializer, fingerprint);
+    Write(serializer, payloadSize);
+}
+
+/**
+ * Write the schema header of a GCLASS(Tagged) class: the fingerprint with kSchemaTableBit
+ * and a table with the name hash, type hash and size of every field
+ */
+template <typename Serializer>
+void WriteSchemaTable(Serializer& serializer, uint64_t fingerprint, std::span<const SchemaField> fields,
+                      std::span<const uint32_t> sizes) {
+    Write(serializer, fingerprint | kSchemaTableBit);
+    WriteLength(serializer, fields.size());
+    for (size_t i = 0; i < fields.size(); ++i) {
+        Write(serializer, fields[i].nameHash);
+        Write(serializer, fields[i].typeHash);
+        Write(serializer, sizes[i]);
+    }
+}
+
+/**
+ * How the properties following a schema header can be read
+ */
+enum class SchemaMatch {
+    Direct,     // Same fingerprint, the properties are read directly
+    Table,      // Another schema with a field table, fields are matched by ReadSchemaTable
+    Unreadable  // Another schema without field table, its properties have been skipped
+};
+
+/**
+ * Read a schema header. With a matching fingerprint a field table is skipped in one
+ * step; otherwise the caller reads the table with ReadSchemaTable. Properties of another
+ * schema without table are skipped here, unless their size was not recorded: the data
+ * after them cannot be located then.
+ */
+template <typename Deserializer>
+SchemaMatch ReadSchemaHeader(Deserializer& deserializer, uint64_t fingerprint, size_t fieldCount) {
+    uint64_t stored = 0;
+    Read(deserializer, stored);
+    if ((stored & kSchemaTableBit) == 0) {
+        uint32_t payloadSize = 0;
+        Read(deserializer, payloadSize);
+        if (stored == fingerprint) {
+            return SchemaMatch::Direct;
+        }
+        if (payloadSize != kUnknownFieldSize) {
+            SkipBytes(deserializer, payloadSize);
+        }
+        return SchemaMatch::Unreadable;
+    }
+    if ((stored & ~kSchemaTableBit) != fingerprint) {
+        return SchemaMatch::Table;
+    }
+    SkipBytes(deserializer, sizeof(uint32_t) + fieldCount * kSchemaEntryBytes);
+    return SchemaMatch::Direct;
+}
+
+/**
+ * Read the field table of a schema header that did not match
+ */
+template <typename Deserializer>
+std::vector<SchemaEntry> ReadSchemaTable(Deserializer& deserializer) {
+    std::vector<SchemaEntry> entries(ReadLength(deserializer));
+    for (auto& entry : entries) {
+        Read(deserializer, entry.nameHash);
+        Read(deserializer, entry.typeHash);
+        Read(deserializer, entry.size);
+    }
+    return entries;
+}
+
+/**
+ * Report data that cannot be read to deserializers that record errors with a Fail member.
+ * The properties that were not read keep their values.
+ */
+template <typename Deserializer>
+void FailSchema(Deserializer& deserializer) {
+    if constexpr (requires { deserializer.Fail(); }) {
+        deserializer.Fail();
+    }
+}
+
+/**
+ * Skip a stored field the class has no property for
+ * @return False if its size is unknown, the rest of the data cannot be located then
+ */
+template <typename Deserializer>
+bool SkipSchemaField(Deserializer& deserializer, const SchemaEntry& entry) {
+    if (entry.size == kUnknownFieldSize) {
+        FailSchema(deserializer);
+        return false;
+    }
+    SkipBytes(deserializer, entry.size);
+    return true;
+}
+
+/**
+ * Index of the field of a schema a stored field can be read into: same name and same
+ * type. -1 if the class has no such field, in which case the stored bytes are skipped.
+ */
+constexpr int FindSchemaField(std::span<const SchemaField> fields, const SchemaEntry& entry) noexcept {
+    for (size_t i = 0; i < fields.size(); ++i) {
+        if (fields[i].nameHash == entry.nameHash && fields[i].typeHash == entry.typeHash) {
+            return static_cast<int>(i);
+        }
+    }
+    return -1;
+}
+
+} // namespace ReflectionRuntime
@@ -0,0 +1,239 @@
+#pragma once
+
+#include <array>
+#include <bit>
+#include <cstdint>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace ReflectionRuntime {
+
+/**
+ * The binary format is little-endian. On little-endian hosts values are copied as-is
+ * and runs of adjacent fields are written with a single copy.
+ */
+inline constexpr bool kBulkCopy = std::endian::native == std::endian::little;
+
+template <typename T>
+struct IsVector : std::false_type {};
+
+template <typename T, typename Allocator>
+struct IsVector<std::vector<T, Allocator>> : std::true_type {};
+
+template <typename T>
+inline constexpr bool kAlwaysFalse = false;
+
+namespace Detail {
+
+struct SerializeMembers {
+    void Serialize();
+    void Deserialize();
+};
+
+// Naming Serialize through the probe is ambiguous exactly when T has a member of that name
+template <typename T>
+struct SerializeProbe : T, SerializeMembers {};
+
+template <typename T>
+concept FinalWithSerializeMember = std::is_final_v<T> && (requires { &T::Serialize; } || requires { &T::Deserialize; });
+
+template <typename T>
+concept OpenWithSerializeMember =
+    !std::is_final_v<T> &&
+    !(requires { &SerializeProbe<T>::Serialize; } && requires { &SerializeProbe<T>::Deserialize; });
+
+} // namespace Detail
+
+/**
+ * Class types with a Serialize or Deserialize member of any signature. Those members
+ * define the format of the type, whichever serializer they accept.
+ */
+template <typename T>
+concept HasSerializeMember =
+    std::is_class_v<T> && (Detail::FinalWithSerializeMember<T> || Detail::OpenWithSerializeMember<T>);
+
+/**
+ * Values whose object representation is their serialized form on little-endian hosts.
+ * bool is excluded because not every byte value is a valid bool, pointers because
+ * their value means nothing in another process, types with Serialize members because
+ * they write themselves. The parser applies the same rules to find bulk-copyable runs.
+ */
+template <typename T>
+inline constexpr bool IsBulkCopyable =
+    std::is_trivially_copyable_v<T> &&
+    !std::is_pointer_v<std::remove_all_extents_t<T>> &&
+    !std::is_member_pointer_v<std::remove_all_extents_t<T>> &&
+    !std::is_same_v<std::remove_all_extents_t<T>, bool> &&
+    !HasSerializeMember<std::remove_all_extents_t<T>>;
+
+template <typename T>
+T ByteSwap(T value) noexcept {
+    static_assert(std::is_arithmetic_v<T>);
+    auto bytes = std::bit_cast<std::array<uint8_t, sizeof(T)>>(value);
+    for (size_t i = 0; i < sizeof(T) / 2; ++i) {
+        std::swap(bytes[i], bytes[sizeof(T) - 1 - i]);
+    }
+    return std::bit_cast<T>(bytes);
+}
+
+template <typename Serializer, typename T>
+void Write(Serializer& serializer, const T& value);
+
+/**
+ * Whether Write accepts a T for this serializer. Types that serialize themselves only
+ * do if their Serialize member takes it, e.g. not when it takes the engine's
+ * BinarySerializer and Serializer is a ByteCounter.
+ */
+template <typename Serializer, typename T>
+constexpr bool CanWrite() noexcept {
+    if constexpr (std::is_arithmetic_v<T> || std::is_enum_v<T> || std::is_same_v<T, std::string>) {
+        return true;
+    } else if constexpr (IsVector<T>::value) {
+        return CanWrite<Serializer, typename T::value_type>();
+    } else if constexpr (std::is_array_v<T>) {
+        return CanWrite<Serializer, std::remove_extent_t<T>>();
+    } else if constexpr (requires(const T& value, Serializer& serializer) { value.Serialize(serializer); }) {
+        return true;
+    } else {
+        return kBulkCopy && IsBulkCopyable<T>;
+    }
+}
+
+/**
+ * Serializer that only counts the bytes written to it
+ */
+struct ByteCounter {
+    size_t size = 0;
+
+    void WriteBytes(const void*, size_t count) noexcept { size += count; }
+};
+
+template <typename Deserializer, typename T>
+void Read(Deserializer& deserializer, T& value);
+
+template <typename Serializer>
+void WriteLength(Serializer& serializer, size_t length) {
+    Write(serializer, static_cast<uint32_t>(length));
+}
+
+template <typename Deserializer>
+size_t ReadLength(Deserializer& deserializer) {
+    uint32_t length = 0;
+    Read(deserializer, length);
+    return length;
+}
+
+/**
+ * Write a value in the binary format.
+ * Strings and vectors are length-prefixed and written with one copy when their
+ * elements allow it. Types with a Serialize member serialize themselves.
+ */
+template <typename Serializer, typename T>
+void Write(Serializer& serializer, const T& value) {
+    if constexpr (std::is_same_v<T, bool>) {
+        uint8_t byte = value ? 1 : 0;
+        serializer.WriteBytes(&byte, 1);
+    } else if constexpr (std::is_enum_v<T>) {
+        Write(serializer, static_cast<std::underlying_type_t<T>>(value));
+    } else if constexpr (std::is_arithmetic_v<T>) {
+        if constexpr (kBulkCopy) {
+            serializer.WriteBytes(&value, sizeof(T));
+        } else {
+            T swapped = ByteSwap(value);
+            serializer.WriteBytes(&swapped, sizeof(T));
+        }
+    } else if constexpr (std::is_same_v<T, std::string>) {
+        WriteLength(serializer, value.size());
+        serializer.WriteBytes(value.data(), value.size());
+    } else if constexpr (IsVector<T>::value) {
+        using Element = typename T::value_type;
+        WriteLength(serializer, value.size());
+        if constexpr (std::is_same_v<Element, bool>) {
+            for (bool element : value) {
+                Write(serializer, element);
+            }
+        } else if constexpr (kBulkCopy && IsBulkCopyable<Element>) {
+            serializer.WriteBytes(value.data(), value.size() * sizeof(Element));
+        } else {
+            for (const auto& element : value) {
+                Write(serializer, element);
+            }
+        }
+    } else if constexpr (std::is_array_v<T>) {
+        if constexpr (kBulkCopy && IsBulkCopyable<T>) {
+            serializer.WriteBytes(&value, sizeof(T));
+        } else {
+            for (const auto& element : value) {
+                Write(serializer, element);
+            }
+        }
+    } else if constexpr (requires { value.Serialize(serializer); }) {
+        value.Serialize(serializer);
+    } else if constexpr (kBulkCopy && IsBulkCopyable<T>) {
+        serializer.WriteBytes(&value, sizeof(T));
+    } else {
+        static_assert(kAlwaysFalse<T>, "No binary serialization for this property type");
+    }
+}
+
+/**
+ * Read a value written by Write
+ */
+template <typename Deserializer, typename T>
+void Read(Deserializer& deserializer, T& value) {
+    if constexpr (std::is_same_v<T, bool>) {
+        uint8_t byte = 0;
+        deserializer.ReadBytes(&byte, 1);
+        value = byte != 0;
+    } else if constexpr (std::is_enum_v<T>) {
+        std::underlying_type_t<T> underlying{};
+        Read(deserializer, underlying);
+        value = static_cast<T>(underlying);
+    } else if constexpr (std::is_arithmetic_v<T>) {
+        deserializer.ReadBytes(&value, sizeof(T));
+        if constexpr (!kBulkCopy) {
+            value = ByteSwap(value);
+        }
+    } else if constexpr (std::is_same_v<T, std::string>) {
+        value.resize(ReadLength(deserializer));
+        deserializer.ReadBytes(value.data(), value.size());
+    } else if constexpr (IsVector<T>::value) {
+        using Element = typename T::value_type;
+        size_t length = ReadLength(deserializer);
+        if constexpr (std::is_same_v<Element, bool>) {
+            value.assign(length, false);
+            for (size_t i = 0; i < length; ++i) {
+                bool element = false;
+                Read(deserializer, element);
+                value[i] = element;
+            }
+        } else {
+            value.resize(length);
+            if constexpr (kBulkCopy && IsBulkCopyable<Element>) {
+                deserializer.ReadBytes(value.data(), length * sizeof(Element));
+            } else {
+                for (auto& element : value) {
+                    Read(deserializer, element);
+                }
+            }
+        }
+    } else if constexpr (std::is_array_v<T>) {
+        if constexpr (kBulkCopy && IsBulkCopyable<T>) {
+            deserializer.ReadBytes(&value, sizeof(T));
+        } else {
+            for (auto& element : value) {
+                Read(deserializer, element);
+            }
+        }
+    } else if constexpr (requires { value.Deserialize(deserializer); }) {
+        value.Deserialize(deserializer);
+    } else if constexpr (kBulkCopy && IsBulkCopyable<T>) {
+        deserializer.ReadBytes(&value, sizeof(T));
+    } else {
+        static_assert(kAlwaysFalse<T>, "No binary deserialization for this property type");
+    }
+}
+
+} // namespace ReflectionRuntime
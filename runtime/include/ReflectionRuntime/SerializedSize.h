@@ -0,0 +1,163 @@
+#pragma once
+
+#include "ReflectionRuntime/BaseCall.h"
+#include "ReflectionRuntime/Schema.h"
+#include "ReflectionRuntime/Serialization.h"
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <type_traits>
+
+namespace ReflectionRuntime {
+
+/**
+ * Marks a serialized size that depends on the value
+ */
+inline constexpr size_t kVariableSize = SIZE_MAX;
+
+/**
+ * Bytes Write produces for every value of T, kVariableSize if it depends on the value
+ */
+template <typename T>
+constexpr size_t GetFixedSerializedSize() noexcept {
+    if constexpr (std::is_same_v<T, bool>) {
+        return 1;
+    } else if constexpr (std::is_enum_v<T>) {
+        return sizeof(std::underlying_type_t<T>);
+    } else if constexpr (std::is_arithmetic_v<T>) {
+        return sizeof(T);
+    } else if constexpr (std::is_array_v<T>) {
+        constexpr size_t element = GetFixedSerializedSize<std::remove_extent_t<T>>();
+        return element == kVariableSize ? kVariableSize : element * std::extent_v<T>;
+    } else if constexpr (requires { GetFixedSerializedSize(static_cast<const T*>(nullptr)); }) {
+        return GetFixedSerializedSize(static_cast<const T*>(nullptr));
+    } else if constexpr (IsBulkCopyable<T>) {
+        return sizeof(T);
+    } else {
+        return kVariableSize;
+    }
+}
+
+template <typename T>
+inline constexpr size_t kFixedSerializedSize = GetFixedSerializedSize<T>();
+
+/**
+ * Bytes Serialize writes for every object of a class, k<Class>SerializedSize. Converts to
+ * the number of bytes; for classes of variable size it has none, so using their size as
+ * a constant does not compile.
+ */
+template <size_t Size>
+struct FixedSerializedSize {
+    static constexpr size_t kValue = Size;
+
+    constexpr operator size_t() const noexcept { return Size; }
+};
+
+template <>
+struct FixedSerializedSize<kVariableSize> {};
+
+/**
+ * Sum of fixed sizes, kVariableSize if any of them is variable
+ */
+template <typename... Sizes>
+constexpr size_t AddFixedSizes(Sizes... sizes) noexcept {
+    size_t total = 0;
+    for (size_t size : {size_t(0), static_cast<size_t>(sizes)...}) {
+        if (size == kVariableSize) {
+            return kVariableSize;
+        }
+        total += size;
+    }
+    return total;
+}
+
+/**
+ * Bytes of the schema header written in front of fieldCount properties, with the field
+ * table of GCLASS(Tagged) classes or with the size of the properties
+ */
+constexpr size_t GetSchemaHeaderSize(size_t fieldCount, bool tagged) noexcept {
+    return sizeof(uint64_t) + sizeof(uint32_t) + (tagged ? fieldCount * kSchemaEntryBytes : 0);
+}
+
+/**
+ * Whether GetSerializedSize can measure a T without the engine's serializer
+ */
+template <typename T>
+constexpr bool CanGetSerializedSize() noexcept {
+    if constexpr (kFixedSerializedSize<T> != kVariableSize || std::is_same_v<T, std::string>) {
+        return true;
+    } else if constexpr (IsVector<T>::value) {
+        return CanGetSerializedSize<typename T::value_type>();
+    } else if constexpr (std::is_array_v<T>) {
+        return CanGetSerializedSize<std::remove_extent_t<T>>();
+    } else if constexpr (requires(const T& value) { SerializedSize(value); }) {
+        return true;
+    } else {
+        return CanWrite<ByteCounter, T>();
+    }
+}
+
+/**
+ * Bytes Write produces for a value. Fixed-size values cost nothing, strings and vectors
+ * of fixed-size elements one multiplication, other containers one pass over the elements.
+ */
+template <typename T>
+size_t GetSerializedSize(const T& value) {
+    if constexpr (kFixedSerializedSize<T> != kVariableSize) {
+        return kFixedSerializedSize<T>;
+    } else if constexpr (std::is_same_v<T, std::string>) {
+        return sizeof(uint32_t) + value.size();
+    } else if constexpr (IsVector<T>::value) {
+        using Element = typename T::value_type;
+        if constexpr (kFixedSerializedSize<Element> != kVariableSize) {
+            return sizeof(uint32_t) + value.size() * kFixedSerializedSize<Element>;
+        } else {
+            size_t size = sizeof(uint32_t);
+            for (const auto& element : value) {
+                size += GetSerializedSize(element);
+            }
+            return size;
+        }
+    } else if constexpr (std::is_array_v<T>) {
+        size_t size = 0;
+        for (const auto& element : value) {
+            size += GetSerializedSize(element);
+        }
+        return size;
+    } else if constexpr (requires { SerializedSize(value); }) {
+        return SerializedSize(value);
+    } else {
+        static_assert(CanGetSerializedSize<T>(), "Serialize member only takes the engine serializer, add a SerializedSize overload");
+        ByteCounter counter;
+        Write(counter, value);
+        return counter.size;
+    }
+}
+
+/**
+ * Size of a field in the field table of a GCLASS(Tagged) class, kUnknownFieldSize if
+ * only the engine's serializer can measure it
+ */
+template <typename T>
+uint32_t GetSchemaFieldSize(const T& value) {
+    if constexpr (CanGetSerializedSize<T>()) {
+        return static_cast<uint32_t>(GetSerializedSize(value));
+    } else {
+        return kUnknownFieldSize;
+    }
+}
+
+/**
+ * Bytes of the properties following the schema header of a class without field table,
+ * kUnknownFieldSize if one of them can only be measured by the engine's serializer
+ */
+template <typename... T>
+uint32_t GetSchemaPayloadSize(const T&... values) {
+    if constexpr ((CanGetSerializedSize<T>() && ...)) {
+        return static_cast<uint32_t>((size_t(0) + ... + GetSerializedSize(values)));
+    } else {
+        return kUnknownFieldSize;
+    }
+}
+
+} // namespace ReflectionRuntime
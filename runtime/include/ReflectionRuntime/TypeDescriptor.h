@@ -0,0 +1,116 @@
+#pragma once
+
+#include "ReflectionRuntime/Invoke.h"
+#include "ReflectionRuntime/NameHash.h"
+#include "ReflectionRuntime/NameIndex.h"
+#include <cstdint>
+#include <span>
+#include <string_view>
+
+namespace ReflectionRuntime {
+
+/**
+ * Property flag bits, matching the GPROPERTY macro flags
+ */
+namespace PropertyFlags {
+    inline constexpr uint32_t None = 0;
+    inline constexpr uint32_t Save = 1u << 0;
+    inline constexpr uint32_t Edit = 1u << 1;
+    inline constexpr uint32_t Transient = 1u << 2;
+    inline constexpr uint32_t EditorOnly = 1u << 3;
+    inline constexpr uint32_t ReadOnly = 1u << 4;
+}
+
+/**
+ * Function flag bits, matching the GFUNCTION macro flags
+ */
+namespace FunctionFlags {
+    inline constexpr uint32_t None = 0;
+    inline constexpr uint32_t Callable = 1u << 0;
+    inline constexpr uint32_t BlueprintEvent = 1u << 1;
+    inline constexpr uint32_t BlueprintCallable = 1u << 2;
+}
+
+/**
+ * Compile-time description of a reflected property
+ */
+struct PropertyDescriptor {
+    std::string_view name;
+    uint32_t offset = 0;
+    uint32_t size = 0;
+    uint32_t flags = PropertyFlags::None;
+    uint64_t typeId = 0;
+
+    constexpr bool HasFlag(uint32_t flag) const noexcept { return (flags & flag) != 0; }
+
+    void* GetPropertyPtr(void* object) const noexcept {
+        return static_cast<char*>(object) + offset;
+    }
+
+    const void* GetPropertyPtr(const void* object) const noexcept {
+        return static_cast<const char*>(object) + offset;
+    }
+};
+
+/**
+ * Compile-time description of a reflected function
+ */
+struct FunctionDescriptor {
+    std::string_view name;
+    uint32_t flags = FunctionFlags::None;
+    FunctionThunk invoke = nullptr;
+    uint32_t parameterCount = 0;
+
+    constexpr bool HasFlag(uint32_t flag) const noexcept { return (flags & flag) != 0; }
+
+    /**
+     * Call the function, see FunctionThunk for the arguments
+     */
+    void Invoke(void* object, void* const* arguments, void* result) const {
+        invoke(object, arguments, result);
+    }
+};
+
+/**
+ * Editor metadata of a property or function, only emitted for editor builds
+ */
+struct MetadataDescriptor {
+    std::string_view category;
+    std::string_view tooltip;
+};
+
+/**
+ * Compile-time description of a reflected type.
+ *
+ * Generated code places descriptors and their arrays in read-only data, so they need
+ * no allocation or initialization at startup and are shared between processes through
+ * the page cache. A runtime GType is a thin view over a TypeDescriptor.
+ */
+struct TypeDescriptor {
+    std::string_view name;
+    uint64_t typeId = 0;
+    uint32_t size = 0;
+    uint32_t alignment = 0;
+    std::span<const PropertyDescriptor> properties;
+    std::span<const FunctionDescriptor> functions;
+
+    // Parallel to properties and functions, empty when editor metadata is stripped
+    std::span<const MetadataDescriptor> propertyMetadata;
+    std::span<const MetadataDescriptor> functionMetadata;
+
+    // Perfect hash lookups from names to indices into properties and functions
+    NameIndex propertyIndex;
+    NameIndex functionIndex;
+
+    constexpr const PropertyDescriptor* FindProperty(std::string_view propertyName) const noexcept {
+        int index = propertyIndex.Find(propertyName);
+        return index == NameIndex::kNotFound ? nullptr : &properties[index];
+    }
+
+    constexpr const FunctionDescriptor* FindFunction(std::string_view functionName) const noexcept {
+        int index = functionIndex.Find(functionName);
+        return index == NameIndex::kNotFound ? nullptr : &functions[index];
+    }
+};
+
+} // namespace ReflectionRuntime
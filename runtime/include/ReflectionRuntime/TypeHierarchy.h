@@ -0,0 +1,129 @@
+#pragma once
+
+#include "ReflectionRuntime/NameHash.h"
+#include <bit>
+#include <cstdint>
+#include <string_view>
+#include <type_traits>
+
+namespace ReflectionRuntime {
+
+/**
+ * Type indices of a reflected class and all classes derived from it. The generator
+ * numbers the hierarchy of a module depth-first, so the subtree of a class is the
+ * contiguous range [first, last] and first is the index of the class itself.
+ * Every class owns the reserved indices starting at first, the classes of other
+ * modules that derive from it are numbered inside them.
+ */
+struct TypeInterval {
+    uint64_t first = 0;
+    uint64_t last = 0;
+    uint64_t reserved = 1;
+
+    /**
+     * Whether the class with the given type index is this class or derives from it.
+     * One unsigned comparison: indices below first wrap around to large values, and
+     * indices of unrelated modules lie outside the interval.
+     */
+    constexpr bool Contains(uint64_t index) const noexcept { return index - first <= last - first; }
+};
+
+/**
+ * Type indices a module numbers one group of its classes in, size is a power of two
+ */
+struct TypeIndexRange {
+    uint64_t first = 0;
+    uint64_t size = 0;
+};
+
+/**
+ * Range of the classes of a module that derive from no reflected class of another
+ * module. The high 16 bits identify the module.
+ */
+constexpr TypeIndexRange GetModuleTypeRange(std::string_view moduleName) noexcept {
+    constexpr uint64_t size = uint64_t(1) << 48;
+    return {HashName(moduleName) & ~(size - 1), size};
+}
+
+/**
+ * Range of the classes of a module that derive from a reflected class of another
+ * module. It is one of 255 slots of the indices reserved by the base, chosen by the
+ * module name; slot 0 starts with the base's own index.
+ */
+constexpr TypeIndexRange GetExtensionRange(const TypeInterval& base, std::string_view moduleName) noexcept {
+    uint64_t size = base.reserved >> 8;
+    return {base.first + (1 + HashName(moduleName) % 255) * size, size};
+}
+
+/**
+ * Interval of the class with the preorder numbers [first, last] among the classCount
+ * classes numbered in range. Each class gets an equal power-of-two share of it.
+ */
+constexpr TypeInterval GetNestedInterval(const TypeIndexRange& range, uint32_t classCount, uint32_t first,
+                                         uint32_t last) noexcept {
+    uint64_t reserved = range.size >> std::bit_width(classCount);
+    return {range.first + first * reserved, range.first + (last + 1) * reserved - 1, reserved};
+}
+
+namespace Detail {
+
+// An engine module with EngineBase and its subclass EngineChild, a game module whose
+// GameObject derives from EngineBase, and a mod module deriving from GameObject
+constexpr TypeInterval kEngineBase = GetNestedInterval(GetModuleTypeRange("Engine"), 2, 0, 1);
+constexpr TypeInterval kEngineChild = GetNestedInterval(GetModuleTypeRange("Engine"), 2, 1, 1);
+constexpr TypeInterval kGameObject = GetNestedInterval(GetExtensionRange(kEngineBase, "Game"), 2, 0, 1);
+constexpr TypeInterval kGameChild = GetNestedInterval(GetExtensionRange(kEngineBase, "Game"), 2, 1, 1);
+constexpr TypeInterval kModObject = GetNestedInterval(GetExtensionRange(kGameObject, "Mod"), 1, 0, 0);
+
+static_assert(kEngineBase.Contains(kGameObject.first) && kEngineBase.Contains(kGameChild.first));
+static_assert(kEngineBase.Contains(kModObject.first) && kGameObject.Contains(kModObject.first));
+static_assert(!kEngineChild.Contains(kGameObject.first) && !kGameChild.Contains(kModObject.first));
+static_assert(!kGameObject.Contains(kEngineBase.first) && !kGameObject.Contains(kEngineChild.first));
+static_assert(kGameObject.last < kEngineChild.first && kModObject.reserved > 1);
+
+} // namespace Detail
+
+/**
+ * One class of a module's generated hierarchy table, its type index is interval.first
+ */
+struct TypeHierarchyEntry {
+    uint64_t typeId = 0;
+    TypeInterval interval;
+};
+
+/**
+ * Type id of a reflected class, HashName of its qualified name. The generated header of
+ * each class defines GetReflectedTypeId next to it, found by ADL.
+ */
+template <typename T>
+inline constexpr uint64_t kTypeId = GetReflectedTypeId(static_cast<const T*>(nullptr));
+
+/**
+ * Type interval of a reflected class, defined by ModuleTypeHierarchy.generated.h
+ */
+template <typename T>
+inline constexpr TypeInterval kTypeInterval = GetTypeInterval(static_cast<const T*>(nullptr));
+
+/**
+ * Whether the class with the given type index is Base or derives from it
+ */
+template <typename Base>
+constexpr bool IsA(uint64_t typeIndex) noexcept {
+    return kTypeInterval<Base>.Contains(typeIndex);
+}
+
+/**
+ * Whether an object is a Base. Statically known relations cost nothing; otherwise the
+ * type index of the object's dynamic class comes from GetTypeIndex(object), which
+ * the engine provides for its root class from the generated hierarchy table.
+ */
+template <typename Base, typename Object>
+bool IsA(const Object& object) noexcept {
+    if constexpr (std::is_base_of_v<Base, Object>) {
+        return true;
+    } else {
+        return IsA<Base>(GetTypeIndex(object));
+    }
+}
+
+} // namespace ReflectionRuntime
@@ -0,0 +1,98 @@
+#pragma once
+
+#include "ReflectionRuntime/NameHash.h"
+#include <algorithm>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <span>
+#include <string_view>
+
+namespace ReflectionRuntime {
+
+/**
+ * One entry of a module's generated registration table
+ */
+struct TypeRegistration {
+    std::string_view name;
+    uint64_t typeId = 0;
+    void (*registerType)() = nullptr;
+};
+
+/**
+ * Registers the types of one module on demand.
+ *
+ * The generator emits a constant table of TypeRegistration entries sorted by name.
+ * Nothing runs during static initialization: a type's registration function is called
+ * the first time the type is resolved, or for every entry when RegisterAll is used.
+ * Registration functions may resolve other types, e.g. their base class.
+ */
+class TypeTable {
+public:
+    explicit TypeTable(std::span<const TypeRegistration> entries)
+        : m_entries(entries)
+        , m_registered(std::make_unique<bool[]>(entries.size())) {}
+
+    TypeTable(const TypeTable&) = delete;
+    TypeTable& operator=(const TypeTable&) = delete;
+
+    /**
+     * Find the entries of a type name without registering them
+     * @param name Type name as registered with the TypeRegistry
+     * @return Entries with that name, empty if the module does not define it
+     */
+    std::span<const TypeRegistration> Find(std::string_view name) const noexcept {
+        auto range = std::equal_range(m_entries.begin(), m_entries.end(), name, NameLess{});
+        return {range.first, range.second};
+    }
+
+    /**
+     * Register every type of the module with the given name, once
+     * @param name Type name as registered with the TypeRegistry
+     * @return True if the module defines the type
+     */
+    bool Resolve(std::string_view name) {
+        auto entries = Find(name);
+        for (const auto& entry : entries) {
+            RegisterEntry(static_cast<size_t>(&entry - m_entries.data()));
+        }
+        return !entries.empty();
+    }
+
+    /**
+     * Register every type of the module, for hosts that want eager registration
+     */
+    void RegisterAll() {
+        for (size_t i = 0; i < m_entries.size(); ++i) {
+            RegisterEntry(i);
+        }
+    }
+
+    std::span<const TypeRegistration> GetEntries() const noexcept { return m_entries; }
+
+private:
+    struct NameLess {
+        bool operator()(const TypeRegistration& entry, std::string_view name) const noexcept {
+            return entry.name < name;
+        }
+        bool operator()(std::string_view name, const TypeRegistration& entry) const noexcept {
+            return name < entry.name;
+        }
+    };
+
+    void RegisterEntry(size_t index) {
+        std::lock_guard<std::recursive_mutex> lock(m_mutex);
+        if (m_registered[index]) {
+            return;
+        }
+        // Marked first so a registration that resolves its own type does not recurse
+        m_registered[index] = true;
+        m_entries[index].registerType();
+    }
+
+    std::span<const TypeRegistration> m_entries;
+    std::unique_ptr<bool[]> m_registered;
+    std::recursive_mutex m_mutex;
+};
+
+} // namespace ReflectionRuntime
@@ -0,0 +1,191 @@
+#pragma once
+
+#include "ReflectionRuntime/Serialization.h"
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace ReflectionRuntime {
+
+/**
+ * Buffers read through generated views must start at this alignment, which mmapped
+ * files and heap allocations do. Variable-size payloads are aligned relative to the
+ * start of the buffer, so vectors can be returned as typed spans.
+ */
+inline constexpr size_t kViewAlignment = alignof(std::max_align_t);
+
+/**
+ * Position of one variable-size property in a view buffer
+ */
+struct ViewEntry {
+    uint32_t offset = 0;
+    uint32_t size = 0;
+};
+
+/**
+ * Accessor types of variable-size properties: strings as std::string_view, vectors of
+ * trivially copyable elements as typed spans, other vectors as their serialized bytes
+ */
+template <typename T>
+struct ViewValue {
+    using Type = std::span<const std::byte>;
+    static constexpr size_t kAlignment = 1;
+};
+
+template <typename Traits, typename Allocator>
+struct ViewValue<std::basic_string<char, Traits, Allocator>> {
+    using Type = std::string_view;
+    static constexpr size_t kAlignment = 1;
+};
+
+template <typename T, typename Allocator>
+    requires (IsBulkCopyable<T> && kBulkCopy)
+struct ViewValue<std::vector<T, Allocator>> {
+    using Type = std::span<const T>;
+    static constexpr size_t kAlignment = alignof(T) < kViewAlignment ? alignof(T) : kViewAlignment;
+};
+
+/**
+ * Size of a fixed-size property in a view buffer
+ */
+template <typename T>
+inline constexpr size_t kViewFixedSize = std::is_same_v<std::remove_cv_t<T>, bool> ? 1 : sizeof(T);
+
+/**
+ * Accessor type of a fixed-size property, arrays are returned as std::array
+ */
+template <typename T>
+using ViewFixedType = std::conditional_t<std::is_array_v<T>,
+                                         std::array<std::remove_cv_t<std::remove_extent_t<T>>, std::extent_v<T>>,
+                                         std::remove_cv_t<T>>;
+
+/**
+ * Read a fixed-size property at its precomputed offset
+ */
+template <typename T>
+ViewFixedType<T> ReadViewFixed(std::span<const std::byte> buffer, size_t offset) noexcept {
+    using Value = ViewFixedType<T>;
+    if constexpr (std::is_same_v<Value, bool>) {
+        return buffer[offset] != std::byte{0};
+    } else {
+        Value value;
+        std::memcpy(&value, buffer.data() + offset, sizeof(Value));
+        if constexpr (!kBulkCopy && std::is_arithmetic_v<Value>) {
+            value = ByteSwap(value);
+        }
+        return value;
+    }
+}
+
+/**
+ * Read a variable-size property through the offset table
+ * @param tableOffset Offset of the offset table in the buffer
+ * @param index Index of the property in the offset table
+ */
+template <typename T>
+typename ViewValue<T>::Type ReadViewVariable(std::span<const std::byte> buffer, size_t tableOffset, size_t index) noexcept {
+    using Type = typename ViewValue<T>::Type;
+    ViewEntry entry = ReadViewFixed<ViewEntry>(buffer, tableOffset + index * sizeof(ViewEntry));
+    const std::byte* data = buffer.data() + entry.offset;
+
+    if constexpr (std::is_same_v<Type, std::string_view>) {
+        return Type(reinterpret_cast<const char*>(data), entry.size);
+    } else {
+        using Element = typename Type::element_type;
+        return Type(reinterpret_cast<const Element*>(data), entry.size / sizeof(Element));
+    }
+}
+
+/**
+ * Check that an offset table entry can be returned as the accessor type of T: it lies
+ * inside the buffer, starts at the alignment of the elements and holds whole elements
+ */
+template <typename T>
+bool IsValidViewEntry(std::span<const std::byte> buffer, ViewEntry entry) noexcept {
+    using Element = typename ViewValue<T>::Type::value_type;
+    if (entry.offset > buffer.size() || entry.size > buffer.size() - entry.offset) {
+        return false;
+    }
+    return reinterpret_cast<uintptr_t>(buffer.data() + entry.offset) % alignof(Element) == 0 &&
+           entry.size % sizeof(Element) == 0;
+}
+
+/**
+ * Check that a buffer is aligned and large enough for its fixed section and offset
+ * table, and that every entry of the table is valid for its property. Accessors do not
+ * check bounds, so buffers from untrusted sources are validated once up front.
+ * @tparam Variables Types of the variable-size properties, in offset table order
+ */
+template <typename... Variables>
+bool IsValidView(std::span<const std::byte> buffer, size_t tableOffset) noexcept {
+    if (reinterpret_cast<uintptr_t>(buffer.data()) % kViewAlignment != 0 ||
+        buffer.size() < tableOffset + sizeof...(Variables) * sizeof(ViewEntry)) {
+        return false;
+    }
+    size_t index = 0;
+    return (IsValidViewEntry<Variables>(buffer, ReadViewFixed<ViewEntry>(buffer, tableOffset + index++ * sizeof(ViewEntry))) &&
+            ...);
+}
+
+/**
+ * Builds a view buffer: the fixed section, the offset table, then the aligned
+ * variable-size payloads
+ */
+class ViewWriter {
+public:
+    ViewWriter(size_t tableOffset, size_t variableCount)
+        : m_tableOffset(tableOffset)
+        , m_bytes(tableOffset + variableCount * sizeof(ViewEntry)) {}
+
+    template <typename T>
+    void AddFixed(size_t offset, const T& value) {
+        if constexpr (std::is_same_v<T, bool>) {
+            m_bytes[offset] = std::byte{value ? uint8_t(1) : uint8_t(0)};
+        } else if constexpr (!kBulkCopy && std::is_arithmetic_v<T>) {
+            T stored = ByteSwap(value);
+            std::memcpy(m_bytes.data() + offset, &stored, sizeof(T));
+        } else {
+            std::memcpy(m_bytes.data() + offset, &value, sizeof(T));
+        }
+    }
+
+    template <typename T>
+    void AddVariable(size_t index, const T& value) {
+        using Type = typename ViewValue<T>::Type;
+        size_t alignment = ViewValue<T>::kAlignment;
+        m_bytes.resize((m_bytes.size() + alignment - 1) / alignment * alignment);
+        size_t begin = m_bytes.size();
+
+        if constexpr (std::is_same_v<Type, std::string_view>) {
+            WriteBytes(value.data(), value.size());
+        } else if constexpr (std::is_same_v<Type, std::span<const std::byte>>) {
+            Write(*this, value);
+        } else {
+            WriteBytes(value.data(), value.size() * sizeof(typename T::value_type));
+        }
+
+        ViewEntry entry{static_cast<uint32_t>(begin), static_cast<uint32_t>(m_bytes.size() - begin)};
+        std::memcpy(m_bytes.data() + m_tableOffset + index * sizeof(ViewEntry), &entry, sizeof(entry));
+    }
+
+    void WriteBytes(const void* data, size_t size) {
+        const auto* bytes = static_cast<const std::byte*>(data);
+        m_bytes.insert(m_bytes.end(), bytes, bytes + size);
+    }
+
+    template <typename Serializer>
+    void Flush(Serializer& serializer) const {
+        serializer.WriteBytes(m_bytes.data(), m_bytes.size());
+    }
+
+private:
+    size_t m_tableOffset;
+    std::vector<std::byte> m_bytes;
+};
+
+} // namespace ReflectionRuntime
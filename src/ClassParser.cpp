@@ -4,9 +4,11 @@
 #include <algorithm>
 #include <cctype>
 #include <memory>
+#include <stdexcept>
 #include <clang/Tooling/CompilationDatabase.h>
 #include <clang/AST/ASTContext.h>
 #include <clang/AST/RecordLayout.h>
+#include <llvm/Support/VirtualFileSystem.h>
 
 namespace ReflectionGenerator {
 
@@ -20,11 +22,18 @@ bool ReflectionASTVisitor::VisitCXXRecordDecl(clang::CXXRecordDecl* decl) {
         return true;
     }
     
+    // The class is already being visited through the TraverseDecl call below
+    if (m_currentClass) {
+        return true;
+    }
+    
     // Check if this class has GCLASS macro
     bool hasGClass = false;
+    std::string annotation;
     for (auto it = decl->specific_attr_begin<clang::AnnotateAttr>(); 
          it != decl->specific_attr_end<clang::AnnotateAttr>(); ++it) {
-        if (it->getAnnotation().str().find("GCLASS") != std::string::npos) {
+        annotation = it->getAnnotation().str();
+        if (annotation.find("GCLASS") != std::string::npos) {
             hasGClass = true;
             break;
         }
@@ -51,10 +60,30 @@ bool ReflectionASTVisitor::VisitCXXRecordDecl(clang::CXXRecordDecl* decl) {
         }
     }
     
+    // Parse GCLASS macro arguments
+    auto classArgs = ParseMacroArguments(annotation);
+    if (classArgs.empty()) {
+        ParseGClassMacro(nullptr, classInfo);
+    } else {
+        ParseClassFlags(classArgs, classInfo);
+    }
+    
     // Get base class
     if (decl->getNumBases() > 0) {
         auto base = decl->bases_begin();
         classInfo.baseClass = GetTypeAsString(base->getType());
+        
+        auto* baseDecl = base->getType()->getAsCXXRecordDecl();
+        if (baseDecl && baseDecl->hasDefinition()) {
+            baseDecl = baseDecl->getDefinition();
+            for (auto it = baseDecl->specific_attr_begin<clang::AnnotateAttr>(); 
+                 it != baseDecl->specific_attr_end<clang::AnnotateAttr>(); ++it) {
+                if (it->getAnnotation().find("GCLASS") != llvm::StringRef::npos) {
+                    classInfo.reflectedBase = GetQualifiedName(baseDecl);
+                    break;
+                }
+            }
+        }
     }
     
     // Set current class for property/function parsing
@@ -63,9 +92,12 @@ bool ReflectionASTVisitor::VisitCXXRecordDecl(clang::CXXRecordDecl* decl) {
     // Traverse the class to find properties and functions
     TraverseDecl(decl);
     
+    // Record size, alignment and the layout of every field
+    CollectRecordLayout(decl, classInfo);
+    
     // Add to data
-    m_data.classes.push_back(classInfo);
     m_currentClass = nullptr;
+    m_data.classes.push_back(std::move(classInfo));
     
     return true;
 }
@@ -94,23 +126,43 @@ bool ReflectionASTVisitor::VisitFieldDecl(clang::FieldDecl* decl) {
     propertyInfo.name = decl->getNameAsString();
     propertyInfo.type = GetTypeAsString(decl->getType());
     propertyInfo.qualifiedType = GetTypeAsString(decl->getType());
+    propertyInfo.kind = GetPropertyKind(decl->getType());
     propertyInfo.fileName = m_context->getSourceManager().getFilename(decl->getLocation()).str();
     propertyInfo.lineNumber = m_context->getSourceManager().getSpellingLineNumber(decl->getLocation());
     
-    // Calculate offset (simplified)
+    // Calculate offset, size and alignment in bytes
     if (auto* record = clang::dyn_cast<clang::CXXRecordDecl>(decl->getParent())) {
-        if (record->isCompleteDefinition()) {
+        if (record->isCompleteDefinition() && !record->isDependentType()) {
             const auto& layout = m_context->getASTRecordLayout(record);
-            propertyInfo.offset = layout.getFieldOffset(decl->getFieldIndex());
+            propertyInfo.offset = m_context->toCharUnitsFromBits(layout.getFieldOffset(decl->getFieldIndex())).getQuantity();
         }
     }
+    if (!decl->getType()->isIncompleteType() && !decl->getType()->isDependentType()) {
+        auto typeInfo = m_context->getTypeInfoInChars(decl->getType());
+        propertyInfo.size = typeInfo.Width.getQuantity();
+        propertyInfo.alignment = typeInfo.Align.getQuantity();
+    }
+    
+    propertyInfo.bitField = decl->isBitField();
+    
+    // Candidates for copying runs of adjacent properties in one go
+    clang::QualType elementType = m_context->getBaseElementType(decl->getType());
+    propertyInfo.bulkCopyable = propertyInfo.size > 0 && !decl->isBitField() &&
+                                decl->getType().isTriviallyCopyableType(*m_context) &&
+                                !elementType->isPointerType() && !elementType->isMemberPointerType() &&
+                                !elementType->isBooleanType() && !HasSerializeMember(elementType);
     
-    // Parse GPROPERTY macro arguments
+    // Parse GPROPERTY macro arguments, a bare GPROPERTY keeps the default flags
     for (auto it = decl->specific_attr_begin<clang::AnnotateAttr>(); 
          it != decl->specific_attr_end<clang::AnnotateAttr>(); ++it) {
         std::string annotation = it->getAnnotation().str();
         if (annotation.find("GPROPERTY") != std::string::npos) {
-            ParseGPropertyMacro(nullptr, propertyInfo); // Simplified for now
+            auto args = ParseMacroArguments(annotation);
+            if (args.empty()) {
+                ParseGPropertyMacro(nullptr, propertyInfo);
+            } else {
+                ParsePropertyFlags(args, propertyInfo);
+            }
             break;
         }
     }
@@ -150,13 +202,20 @@ bool ReflectionASTVisitor::VisitCXXMethodDecl(clang::CXXMethodDecl* decl) {
         functionInfo.parameters.push_back(param->getNameAsString());
         functionInfo.parameterTypes.push_back(GetTypeAsString(param->getType()));
     }
+    functionInfo.pointerType = GetFunctionPointerType(decl);
+    functionInfo.isStatic = decl->isStatic();
     
-    // Parse GFUNCTION macro arguments
+    // Parse GFUNCTION macro arguments, a bare GFUNCTION keeps the default flags
     for (auto it = decl->specific_attr_begin<clang::AnnotateAttr>(); 
          it != decl->specific_attr_end<clang::AnnotateAttr>(); ++it) {
         std::string annotation = it->getAnnotation().str();
         if (annotation.find("GFUNCTION") != std::string::npos) {
-            ParseGFunctionMacro(nullptr, functionInfo); // Simplified for now
+            auto args = ParseMacroArguments(annotation);
+            if (args.empty()) {
+                ParseGFunctionMacro(nullptr, functionInfo);
+            } else {
+                ParseFunctionFlags(args, functionInfo);
+            }
             break;
         }
     }
@@ -210,6 +269,100 @@ std::string ReflectionASTVisitor::GetQualifiedName(clang::NamedDecl* decl) {
     return qualifiedName;
 }
 
+PropertyKind ReflectionASTVisitor::GetPropertyKind(clang::QualType type) {
+    if (type.isNull() || type->isDependentType()) {
+        return PropertyKind::Other;
+    }
+    
+    clang::QualType canonicalType = type.getCanonicalType();
+    if (canonicalType->isBooleanType()) {
+        return PropertyKind::Bool;
+    }
+    if (canonicalType->isEnumeralType()) {
+        return PropertyKind::Enum;
+    }
+    if (canonicalType->isIntegerType()) {
+        return PropertyKind::Integer;
+    }
+    if (canonicalType->isRealFloatingType()) {
+        return PropertyKind::Float;
+    }
+    
+    if (const auto* record = canonicalType->getAsCXXRecordDecl()) {
+        if (record->isInStdNamespace() && record->getIdentifier()) {
+            llvm::StringRef name = record->getName();
+            if (name == "basic_string") {
+                return PropertyKind::String;
+            }
+            if (name == "vector") {
+                return PropertyKind::Vector;
+            }
+        }
+    }
+    
+    return PropertyKind::Other;
+}
+
+bool ReflectionASTVisitor::IsDirtyBitsType(clang::QualType type) {
+    const auto* record = type.getCanonicalType()->getAsCXXRecordDecl();
+    if (!record || !record->getIdentifier() || record->getName() != "DirtyBits") {
+        return false;
+    }
+    const auto* ns = clang::dyn_cast<clang::NamespaceDecl>(record->getDeclContext());
+    return ns && ns->getName() == "ReflectionRuntime";
+}
+
+bool ReflectionASTVisitor::HasSerializeMember(clang::QualType type) {
+    // Matches ReflectionRuntime::HasSerializeMember: any member named Serialize or
+    // Deserialize, declared in the class or inherited
+    const auto* record = type.getCanonicalType()->getAsCXXRecordDecl();
+    if (!record || !record->hasDefinition()) {
+        return false;
+    }
+    record = record->getDefinition();
+
+    clang::IdentifierInfo& serialize = m_context->Idents.get("Serialize");
+    clang::IdentifierInfo& deserialize = m_context->Idents.get("Deserialize");
+    auto declares = [&](const clang::CXXRecordDecl* decl) {
+        return !decl->lookup(&serialize).empty() || !decl->lookup(&deserialize).empty();
+    };
+    return declares(record) || !record->forallBases([&](const clang::CXXRecordDecl* base) {
+        return !declares(base);
+    });
+}
+
+std::string ReflectionASTVisitor::GetFunctionPointerType(clang::CXXMethodDecl* decl) {
+    // GetTypeAsString drops the spaces that separate qualifiers, so spell the types
+    // with a printing policy that produces valid code
+    clang::PrintingPolicy policy(m_context->getLangOpts());
+    policy.FullyQualifiedName = true;
+    policy.SuppressScope = false;
+    policy.PrintCanonicalTypes = true;
+    
+    std::string parameters;
+    for (auto* param : decl->parameters()) {
+        if (!parameters.empty()) {
+            parameters += ", ";
+        }
+        parameters += param->getType().getCanonicalType().getAsString(policy);
+    }
+    
+    std::string pointer = decl->isStatic() ? "(*)" : "(" + GetQualifiedName(decl->getParent()) + "::*)";
+    std::string type = decl->getReturnType().getCanonicalType().getAsString(policy) + " " + pointer + "(" + parameters + ")";
+    if (decl->isConst()) {
+        type += " const";
+    }
+    if (decl->getRefQualifier() == clang::RQ_LValue) {
+        type += " &";
+    } else if (decl->getRefQualifier() == clang::RQ_RValue) {
+        type += " &&";
+    }
+    if (const auto* prototype = decl->getType()->getAs<clang::FunctionProtoType>(); prototype && prototype->isNothrow()) {
+        type += " noexcept";
+    }
+    return type;
+}
+
 std::string ReflectionASTVisitor::GetTypeAsString(clang::QualType type) {
     if (type.isNull()) {
         return "";
@@ -248,6 +401,61 @@ std::string ReflectionASTVisitor::GetTypeAsString(clang::QualType type) {
     return cleanedName;
 }
 
+void ReflectionASTVisitor::CollectRecordLayout(clang::CXXRecordDecl* decl, ClassInfo& classInfo) {
+    if (decl->isInvalidDecl() || decl->isDependentType()) {
+        return;
+    }
+    
+    const auto& layout = m_context->getASTRecordLayout(decl);
+    classInfo.size = layout.getSize().getQuantity();
+    classInfo.alignment = layout.getAlignment().getQuantity();
+    
+    // Everything in front of the own fields: vtable pointer and non-virtual bases
+    size_t baseSize = 0;
+    if (layout.hasOwnVFPtr()) {
+        baseSize = m_context->getTypeSizeInChars(m_context->VoidPtrTy).getQuantity();
+    }
+    for (const auto& base : decl->bases()) {
+        auto* baseDecl = base.getType()->getAsCXXRecordDecl();
+        if (!baseDecl || base.isVirtual()) {
+            continue;
+        }
+        size_t baseOffset = layout.getBaseClassOffset(baseDecl).getQuantity();
+        size_t baseDataSize = m_context->getASTRecordLayout(baseDecl).getDataSize().getQuantity();
+        baseSize = std::max(baseSize, baseOffset + baseDataSize);
+    }
+    classInfo.baseSize = baseSize;
+    
+    for (auto* field : decl->fields()) {
+        FieldLayout fieldLayout;
+        fieldLayout.name = field->getNameAsString();
+        fieldLayout.type = GetTypeAsString(field->getType());
+        
+        uint64_t offsetBits = layout.getFieldOffset(field->getFieldIndex());
+        fieldLayout.offset = m_context->toCharUnitsFromBits(offsetBits).getQuantity();
+        
+        if (field->isBitField()) {
+            // Bytes touched by the bit-field, it cannot be moved on its own
+            uint64_t width = field->getBitWidthValue(*m_context);
+            fieldLayout.bitField = true;
+            fieldLayout.size = static_cast<size_t>((offsetBits % 8 + width + 7) / 8);
+        } else if (!field->getType()->isIncompleteType() && !field->getType()->isDependentType()) {
+            auto typeInfo = m_context->getTypeInfoInChars(field->getType());
+            fieldLayout.size = typeInfo.Width.getQuantity();
+            fieldLayout.alignment = typeInfo.Align.getQuantity();
+        }
+        
+        if (const auto* property = classInfo.GetProperty(fieldLayout.name)) {
+            fieldLayout.property = true;
+            fieldLayout.save = property->save && !property->transient;
+        } else if (IsDirtyBitsType(field->getType())) {
+            classInfo.dirtyBitsMember = fieldLayout.name;
+        }
+        
+        classInfo.fields.push_back(std::move(fieldLayout));
+    }
+}
+
 std::string ReflectionASTVisitor::GetSourceText(clang::SourceRange range) {
     if (range.isInvalid()) {
         return "";
@@ -297,15 +505,41 @@ std::vector<std::string> ReflectionASTVisitor::ParseMacroArguments(const std::st
         return args;
     }
     
-    // Extract arguments
+    // Extract arguments, splitting only on top-level commas so that
+    // Clamp(0, 100) and Tooltip("a, b") stay single arguments
     std::string argsText = macroText.substr(start + 1, end - start - 1);
-    args = SplitString(argsText, ',');
-    
-    // Trim whitespace from each argument
-    for (auto& arg : args) {
-        arg = TrimWhitespace(arg);
+    std::string current;
+    int depth = 0;
+    bool inString = false;
+    
+    for (size_t i = 0; i < argsText.size(); ++i) {
+        char c = argsText[i];
+        if (inString) {
+            if (c == '\\' && i + 1 < argsText.size()) {
+                current += c;
+                c = argsText[++i];
+            } else if (c == '"') {
+                inString = false;
+            }
+        } else if (c == '"') {
+            inString = true;
+        } else if (c == '(') {
+            depth++;
+        } else if (c == ')') {
+            depth--;
+        } else if (c == ',' && depth == 0) {
+            args.push_back(TrimWhitespace(current));
+            current.clear();
+            continue;
+        }
+        current += c;
     }
     
+    args.push_back(TrimWhitespace(current));
+    
+    // Drop empty arguments
+    args.erase(std::remove(args.begin(), args.end(), std::string()), args.end());
+    
     return args;
 }
 
@@ -319,6 +553,16 @@ void ReflectionASTVisitor::ParseClassFlags(const std::vector<std::string>& args,
             classInfo.abstract = true;
         } else if (arg == "DefaultToInstanced") {
             classInfo.defaultToInstanced = true;
+        } else if (arg == "SoA") {
+            classInfo.soa = true;
+        } else if (arg == "Replicated") {
+            classInfo.replicated = true;
+        } else if (arg == "Pooled") {
+            classInfo.allocation = AllocationMode::Pool;
+        } else if (arg == "Arena") {
+            classInfo.allocation = AllocationMode::Arena;
+        } else if (arg == "Tagged") {
+            classInfo.tagged = true;
         } else if (arg.find("Version=") == 0) {
             std::string versionStr = arg.substr(8);
             classInfo.version = std::stoul(versionStr);
@@ -357,6 +601,18 @@ void ReflectionASTVisitor::ParsePropertyFlags(const std::vector<std::string>& ar
                     propertyInfo.clampMax = TrimWhitespace(clampArgs[1]);
                 }
             }
+        } else if (arg.find("Quantize(") == 0) {
+            // Extract the number of bits of a quantized float
+            size_t start = arg.find('(');
+            size_t end = arg.rfind(')');
+            if (start != std::string::npos && end != std::string::npos && end > start) {
+                std::string bitsText = TrimWhitespace(arg.substr(start + 1, end - start - 1));
+                bool isNumber = !bitsText.empty() &&
+                                std::all_of(bitsText.begin(), bitsText.end(), [](unsigned char c) { return std::isdigit(c); });
+                if (isNumber) {
+                    propertyInfo.quantizeBits = static_cast<uint32_t>(std::min(std::stoul(bitsText), 32ul));
+                }
+            }
         } else if (arg.find("Default(") == 0) {
             // Extract default value
             size_t start = arg.find('(');
@@ -435,6 +691,12 @@ ReflectionASTConsumer::ReflectionASTConsumer(clang::ASTContext* context, Reflect
 
 void ReflectionASTConsumer::HandleTranslationUnit(clang::ASTContext& context) {
     m_visitor->TraverseDecl(context.getTranslationUnitDecl());
+    
+    // Layouts depend on every header that was read, not just the parsed one
+    clang::SourceManager& sm = context.getSourceManager();
+    for (auto it = sm.fileinfo_begin(); it != sm.fileinfo_end(); ++it) {
+        m_data.dependencies.push_back(it->first.getName().str());
+    }
 }
 
 // ReflectionFrontendAction implementation
@@ -464,15 +726,23 @@ ClassParser::ClassParser() {
 }
 
 std::vector<ClassInfo> ClassParser::ParseFile(const std::string& filePath) {
+    std::vector<std::string> dependencies;
+    return ParseFile(filePath, dependencies);
+}
+
+std::vector<ClassInfo> ClassParser::ParseFile(const std::string& filePath, std::vector<std::string>& dependencies) {
     ReflectionData data;
     data.fileName = filePath;
     
     // Build compiler arguments
     std::vector<std::string> args = BuildCompilerArgs(filePath);
     
-    // Create tool
+    // Create tool. Each tool gets its own physical file system so that the working
+    // directory is not shared with tools running on other scheduler threads.
     auto compilations = std::make_unique<clang::tooling::FixedCompilationDatabase>(".", args);
-    clang::tooling::ClangTool tool(*compilations, {filePath});
+    clang::tooling::ClangTool tool(*compilations, {filePath},
+                                   std::make_shared<clang::PCHContainerOperations>(),
+                                   llvm::vfs::createPhysicalFileSystem());
     
     // Create a custom factory
     class ReflectionActionFactory : public clang::tooling::FrontendActionFactory {
@@ -492,24 +762,33 @@ std::vector<ClassInfo> ClassParser::ParseFile(const std::string& filePath) {
     int result = tool.run(&factory);
     
     if (result != 0) {
-        std::cerr << "Error parsing file: " << filePath << "\n";
-        return {};
+        throw std::runtime_error("Error parsing file: " + filePath);
     }
     
-    return data.classes;
+    dependencies = std::move(data.dependencies);
+    return std::move(data.classes);
 }
 
 std::vector<ClassInfo> ClassParser::ParseFiles(const std::vector<std::string>& filePaths) {
     std::vector<ClassInfo> allClasses;
     
-    for (const auto& filePath : filePaths) {
-        auto classes = ParseFile(filePath);
-        allClasses.insert(allClasses.end(), classes.begin(), classes.end());
-    }
+    ParseFiles(filePaths, [&allClasses](const std::string&, std::vector<ClassInfo>&& classes) {
+        allClasses.insert(allClasses.end(),
+                          std::make_move_iterator(classes.begin()),
+                          std::make_move_iterator(classes.end()));
+    });
     
     return allClasses;
 }
 
+void ClassParser::ParseFiles(const std::vector<std::string>& filePaths, const FileCallback& callback) {
+    // ParseFile runs one ClangTool per file, so each AST is destroyed before the
+    // next file is parsed and only the extracted metadata reaches the callback
+    for (const auto& filePath : filePaths) {
+        callback(filePath, ParseFile(filePath));
+    }
+}
+
 void ClassParser::SetIncludeDirectories(const std::vector<std::string>& includeDirs) {
     m_includeDirs = includeDirs;
 }
@@ -4,6 +4,7 @@
 #include <string>
 #include <vector>
 #include <memory>
+#include <functional>
 
 // Clang includes
 #include "clang/Tooling/Tooling.h"
@@ -39,7 +40,12 @@ private:
     // Helper methods
     std::string GetQualifiedName(clang::NamedDecl* decl);
     std::string GetTypeAsString(clang::QualType type);
+    PropertyKind GetPropertyKind(clang::QualType type);
+    bool IsDirtyBitsType(clang::QualType type);
+    bool HasSerializeMember(clang::QualType type);
+    std::string GetFunctionPointerType(clang::CXXMethodDecl* decl);
     std::string GetSourceText(clang::SourceRange range);
+    void CollectRecordLayout(clang::CXXRecordDecl* decl, ClassInfo& classInfo);
     
     // Macro parsing
     void ParseGClassMacro(clang::MacroExpansion* expansion, ClassInfo& classInfo);
@@ -93,6 +99,11 @@ private:
  */
 class ClassParser {
 public:
+    /**
+     * Receives the classes of one file as soon as its AST has been visited and released
+     */
+    using FileCallback = std::function<void(const std::string& filePath, std::vector<ClassInfo>&& classes)>;
+
     ClassParser();
     ~ClassParser() = default;
 
@@ -100,9 +111,19 @@ public:
      * Parse a C++ file and extract reflection information
      * @param filePath Path to the C++ file
      * @return Vector of ClassInfo objects found in the file
+     * @throws std::runtime_error if the file cannot be parsed
      */
     std::vector<ClassInfo> ParseFile(const std::string& filePath);
 
+    /**
+     * Parse a C++ file and report the files it depends on
+     * @param filePath Path to the C++ file
+     * @param dependencies Receives the paths of every file the parse read, including filePath
+     * @return Vector of ClassInfo objects found in the file
+     * @throws std::runtime_error if the file cannot be parsed
+     */
+    std::vector<ClassInfo> ParseFile(const std::string& filePath, std::vector<std::string>& dependencies);
+
     /**
      * Parse multiple files
      * @param filePaths Vector of file paths
@@ -110,6 +131,13 @@ public:
      */
     std::vector<ClassInfo> ParseFiles(const std::vector<std::string>& filePaths);
 
+    /**
+     * Parse multiple files without accumulating their classes
+     * @param filePaths Vector of file paths
+     * @param callback Called once per file, after the file's AST has been destroyed
+     */
+    void ParseFiles(const std::vector<std::string>& filePaths, const FileCallback& callback);
+
     /**
      * Set additional include directories for parsing
      * @param includeDirs Vector of include directory paths
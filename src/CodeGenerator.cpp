@@ -1,13 +1,17 @@
 #include "CodeGenerator.h"
+#include "PerfectHash.h"
 #include <iostream>
 #include <sstream>
 #include <algorithm>
 #include <filesystem>
+#include <cctype>
+#include <stdexcept>
 
 namespace ReflectionGenerator {
 
-CodeGenerator::CodeGenerator(const std::string& outputDir)
-    : m_outputDir(outputDir) {
+CodeGenerator::CodeGenerator(const std::string& outputDir, const GeneratorOptions& options)
+    : m_outputDir(outputDir), m_options(options),
+      m_moduleName(GetDefaultModuleName(options.moduleName.empty() ? outputDir : options.moduleName)) {
     EnsureDirectoryExists(m_outputDir);
 }
 
@@ -23,6 +27,22 @@ void CodeGenerator::GenerateCode(const std::string& filePath, const std::vector<
         
         GenerateHeader(classInfo, headerPath);
         GenerateImplementation(classInfo, implPath);
+        
+        for (const auto& property : classInfo.properties) {
+            if (property.bitField) {
+                std::cerr << "Warning: Property " << classInfo.name << "::" << property.name
+                          << " is a bit-field and is not reflected\n";
+            }
+        }
+        
+        if (classInfo.replicated && classInfo.dirtyBitsMember.empty()) {
+            std::cerr << "Warning: Replicated class " << classInfo.name
+                      << " has no ReflectionRuntime::DirtyBits member, no delta serialization generated\n";
+        }
+        
+        if (HasExtensionHeader(classInfo)) {
+            GenerateExtensionHeader(classInfo, GetOutputPath(filePath, classInfo.name + ".ext.generated.h"));
+        }
     }
     
     // Generate registration file if there are multiple classes
@@ -37,8 +57,7 @@ void CodeGenerator::GenerateHeader(const ClassInfo& classInfo, const std::string
     
     std::ofstream file(outputPath);
     if (!file.is_open()) {
-        std::cerr << "Error: Cannot open file for writing: " << outputPath << "\n";
-        return;
+        throw std::runtime_error("Cannot open file for writing: " + outputPath);
     }
     
     WriteHeaderPreamble(file, classInfo);
@@ -54,8 +73,7 @@ void CodeGenerator::GenerateImplementation(const ClassInfo& classInfo, const std
     
     std::ofstream file(outputPath);
     if (!file.is_open()) {
-        std::cerr << "Error: Cannot open file for writing: " << outputPath << "\n";
-        return;
+        throw std::runtime_error("Cannot open file for writing: " + outputPath);
     }
     
     WriteImplementationPreamble(file, classInfo);
@@ -66,13 +84,99 @@ void CodeGenerator::GenerateImplementation(const ClassInfo& classInfo, const std
     file.close();
 }
 
+void CodeGenerator::GenerateExtensionHeader(const ClassInfo& classInfo, const std::string& outputPath) {
+    EnsureDirectoryExists(std::filesystem::path(outputPath).parent_path().string());
+    
+    std::ofstream file(outputPath);
+    if (!file.is_open()) {
+        throw std::runtime_error("Cannot open file for writing: " + outputPath);
+    }
+    
+    std::string guard = GetIncludeGuard(classInfo.name + "_EXT");
+    file << "#ifndef " << guard << "\n";
+    file << "#define " << guard << "\n\n";
+    file << "// Generated header-only reflection code for class " << classInfo.name << "\n";
+    file << "// This file is automatically generated by the reflection generator\n";
+    file << "// Do not edit this file manually\n\n";
+    
+    // Everything here works on members, so the class definition is needed
+    if (!classInfo.fileName.empty()) {
+        file << "#include \"" << GetRelativePath(outputPath, classInfo.fileName) << "\"\n";
+    }
+    if (!GetIncludedProperties(classInfo).empty()) {
+        file << "#include \"ReflectionRuntime/Properties.h\"\n";
+    }
+    if (!GetViewProperties(classInfo).empty()) {
+        file << "#include \"ReflectionRuntime/View.h\"\n";
+    }
+    if (classInfo.soa) {
+        file << "#include \"ReflectionRuntime/Column.h\"\n";
+    }
+    if (HasSerializedProperties(classInfo)) {
+        // JSON reading dispatches keys through the property name index declared there
+        std::string headerName = std::filesystem::path(outputPath).filename().string();
+        headerName.replace(headerName.rfind(".ext.generated.h"), std::string::npos, ".generated.h");
+        file << "#include \"" << headerName << "\"\n";
+        file << "#include \"ReflectionRuntime/Hash.h\"\n";
+        file << "#include \"ReflectionRuntime/Json.h\"\n";
+        file << "#include \"ReflectionRuntime/Patch.h\"\n";
+        file << "#include \"ReflectionRuntime/SerializedSize.h\"\n";
+        file << "#include <cstddef>\n";
+        file << "#include <cstring>\n";
+    }
+    if (HasBatchFunctions(classInfo)) {
+        file << "#include \"ReflectionRuntime/Batch.h\"\n";
+        file << "#include <vector>\n";
+    }
+    if (HasCompactFunctions(classInfo)) {
+        file << "#include \"ReflectionRuntime/BitPacking.h\"\n";
+    }
+    if (HasDeltaFunctions(classInfo)) {
+        file << "#include \"ReflectionRuntime/DirtyBits.h\"\n";
+        file << "#include \"ReflectionRuntime/Serialization.h\"\n";
+        file << "#include <utility>\n";
+    }
+    file << "\n";
+    
+    file << GetNamespacePrefix(classInfo.namespaceName);
+    if (!GetIncludedProperties(classInfo).empty()) {
+        WritePropertyFields(file, classInfo);
+    }
+    if (!GetViewProperties(classInfo).empty()) {
+        WriteViewClass(file, classInfo);
+    }
+    if (classInfo.soa) {
+        WriteSoAClass(file, classInfo);
+    }
+    if (HasSerializedProperties(classInfo)) {
+        if (classInfo.serializable) {
+            WriteSerializedSize(file, classInfo);
+        }
+        WriteHashFunctions(file, classInfo);
+        WriteJsonFunctions(file, classInfo);
+        WritePatchFunctions(file, classInfo);
+    }
+    if (HasBatchFunctions(classInfo)) {
+        WriteBatchFunctions(file, classInfo);
+    }
+    if (HasCompactFunctions(classInfo)) {
+        WriteCompactFunctions(file, classInfo);
+    }
+    if (HasDeltaFunctions(classInfo)) {
+        WriteDeltaFunctions(file, classInfo);
+    }
+    file << GetNamespaceSuffix(classInfo.namespaceName);
+    
+    file << "\n#endif // " << guard << "\n";
+    file.close();
+}
+
 void CodeGenerator::GenerateRegistration(const std::vector<ClassInfo>& classes, const std::string& outputPath) {
     EnsureDirectoryExists(std::filesystem::path(outputPath).parent_path().string());
     
     std::ofstream file(outputPath);
     if (!file.is_open()) {
-        std::cerr << "Error: Cannot open file for writing: " << outputPath << "\n";
-        return;
+        throw std::runtime_error("Cannot open file for writing: " + outputPath);
     }
     
     file << "// Generated registration code\n";
@@ -103,6 +207,290 @@ void CodeGenerator::GenerateRegistration(const std::vector<ClassInfo>& classes,
     file.close();
 }
 
+void CodeGenerator::GenerateModuleRegistration(const std::vector<ClassSummary>& classes) {
+    GenerateTypeHierarchy(classes);
+    
+    std::string outputPath = m_outputDir + "/ModuleRegistration.generated.cpp";
+    
+    std::ofstream file(outputPath);
+    if (!file.is_open()) {
+        throw std::runtime_error("Cannot open file for writing: " + outputPath);
+    }
+    
+    file << "// Generated module registration code\n";
+    file << "// This file is automatically generated by the reflection generator\n\n";
+    
+    // Without the lazy table every implementation file registers its class from a static
+    // initializer, so a module-wide function would register each type a second time
+    if (!m_options.lazyRegistration) {
+        file << "// Types of this module register themselves during static initialization\n";
+        file.close();
+        return;
+    }
+    
+    // Include all generated headers
+    for (const auto& classInfo : classes) {
+        file << "#include \"" << std::filesystem::path(GetOutputPath(classInfo.fileName, classInfo.name + ".generated.h")).filename().string() << "\"\n";
+    }
+    file << "#include \"ReflectionRuntime/TypeTable.h\"\n";
+    
+    file << "\nnamespace Engine {\n";
+    file << "namespace Core {\n\n";
+    
+    WriteModuleTypeTable(file, classes);
+    
+    file << "} // namespace Core\n";
+    file << "} // namespace Engine\n";
+    
+    file.close();
+}
+
+void CodeGenerator::GenerateTypeHierarchy(const std::vector<ClassSummary>& classes) {
+    std::string outputPath = m_outputDir + "/ModuleTypeHierarchy.generated.h";
+    
+    std::ofstream file(outputPath);
+    if (!file.is_open()) {
+        throw std::runtime_error("Cannot open file for writing: " + outputPath);
+    }
+    
+    // Children in name order, so the numbering only changes when the hierarchy does
+    std::vector<const ClassSummary*> sorted;
+    for (const auto& classInfo : classes) {
+        sorted.push_back(&classInfo);
+    }
+    std::sort(sorted.begin(), sorted.end(), [](const ClassSummary* a, const ClassSummary* b) {
+        return a->qualifiedName < b->qualifiedName;
+    });
+    
+    // Bases outside the module, like the engine's GObject, make their subclasses roots.
+    // Roots of a reflected base in another module are numbered inside the indices that
+    // base reserves, in one group per base; group 0 holds all other roots
+    std::vector<std::vector<size_t>> children(sorted.size());
+    std::vector<std::string> groupBases{""};
+    std::vector<std::vector<size_t>> groupRoots(1);
+    for (size_t i = 0; i < sorted.size(); ++i) {
+        size_t parent = FindBaseClass(sorted, *sorted[i]);
+        if (parent != sorted.size()) {
+            children[parent].push_back(i);
+            continue;
+        }
+        auto group = std::find(groupBases.begin(), groupBases.end(), sorted[i]->reflectedBase);
+        if (group == groupBases.end()) {
+            groupBases.push_back(sorted[i]->reflectedBase);
+            groupRoots.emplace_back();
+            group = groupBases.end() - 1;
+        }
+        groupRoots[group - groupBases.begin()].push_back(i);
+    }
+    
+    // Depth-first numbering of each group, a subtree covers the numbers [first, last]
+    std::vector<size_t> preorder;
+    std::vector<size_t> groups(sorted.size());
+    std::vector<uint32_t> groupCounts;
+    std::vector<uint32_t> first(sorted.size()), last(sorted.size());
+    for (size_t group = 0; group < groupRoots.size(); ++group) {
+        size_t groupStart = preorder.size();
+        std::vector<size_t> stack(groupRoots[group].rbegin(), groupRoots[group].rend());
+        while (!stack.empty()) {
+            size_t index = stack.back();
+            stack.pop_back();
+            first[index] = static_cast<uint32_t>(preorder.size() - groupStart);
+            groups[index] = group;
+            preorder.push_back(index);
+            stack.insert(stack.end(), children[index].rbegin(), children[index].rend());
+        }
+        groupCounts.push_back(static_cast<uint32_t>(preorder.size() - groupStart));
+    }
+    
+    // Descendants come later in preorder, so walking backwards finishes them first
+    for (auto it = preorder.rbegin(); it != preorder.rend(); ++it) {
+        last[*it] = children[*it].empty() ? first[*it] : last[children[*it].back()];
+    }
+    
+    auto getRange = [&](size_t group) {
+        std::string range = "Engine::Core::k" + m_moduleName + "TypeRange";
+        return group == 0 ? range : range + std::to_string(group);
+    };
+    auto getInterval = [&](size_t index) {
+        return "ReflectionRuntime::GetNestedInterval(" + getRange(groups[index]) + ", " +
+               std::to_string(groupCounts[groups[index]]) + ", " + std::to_string(first[index]) + ", " +
+               std::to_string(last[index]) + ")";
+    };
+    
+    std::string guard = GetIncludeGuard(m_moduleName + "TypeHierarchy");
+    file << "#ifndef " << guard << "\n";
+    file << "#define " << guard << "\n\n";
+    file << "// Generated type hierarchy of the module\n";
+    file << "// This file is automatically generated by the reflection generator\n";
+    file << "// Do not edit this file manually\n\n";
+    file << "#include \"ReflectionRuntime/TypeHierarchy.h\"\n\n";
+    
+    // Classes of different modules never share an index: the module's own roots are
+    // numbered in a range derived from the module name, and subclasses of another
+    // module's classes inside the indices those classes reserve
+    file << "namespace Engine {\n";
+    file << "namespace Core {\n\n";
+    file << "inline constexpr ReflectionRuntime::TypeIndexRange k" << m_moduleName
+         << "TypeRange = ReflectionRuntime::GetModuleTypeRange(\"" << m_moduleName << "\");\n";
+    if (groupBases.size() > 1) {
+        file << "\n// The hierarchy headers of the modules these bases belong to must be included first\n";
+    }
+    for (size_t group = 1; group < groupBases.size(); ++group) {
+        std::string range = "k" + m_moduleName + "TypeRange" + std::to_string(group);
+        file << "inline constexpr ReflectionRuntime::TypeIndexRange " << range
+             << " = ReflectionRuntime::GetExtensionRange(ReflectionRuntime::kTypeInterval<::" << groupBases[group]
+             << ">, \"" << m_moduleName << "\");\n";
+        file << "static_assert(ReflectionRuntime::GetNestedInterval(" << range << ", " << groupCounts[group]
+             << ", 0, 0).reserved > 0, \"No type indices left below " << groupBases[group] << "\");\n";
+    }
+    file << "\n} // namespace Core\n";
+    file << "} // namespace Engine\n\n";
+    
+    // Found by ADL through ReflectionRuntime::kTypeInterval
+    for (size_t i = 0; i < preorder.size(); ++i) {
+        const ClassSummary& classInfo = *sorted[preorder[i]];
+        if (i == 0 || sorted[preorder[i - 1]]->namespaceName != classInfo.namespaceName) {
+            file << GetNamespacePrefix(classInfo.namespaceName);
+        }
+        file << "class " << classInfo.name << ";\n";
+        file << "constexpr ReflectionRuntime::TypeInterval GetTypeInterval(const " << classInfo.name
+             << "*) noexcept { return " << getInterval(preorder[i]) << "; }\n";
+        if (i + 1 == preorder.size() || sorted[preorder[i + 1]]->namespaceName != classInfo.namespaceName) {
+            file << GetNamespaceSuffix(classInfo.namespaceName);
+        }
+    }
+    
+    file << "\nnamespace Engine {\n";
+    file << "namespace Core {\n\n";
+    file << "inline constexpr uint32_t k" << m_moduleName << "TypeCount = " << preorder.size() << ";\n\n";
+    if (!preorder.empty()) {
+        file << "// In preorder within each range, the type index of a class is the first of its interval\n";
+        file << "inline constexpr ReflectionRuntime::TypeHierarchyEntry k" << m_moduleName << "TypeHierarchy[] = {\n";
+        for (size_t index : preorder) {
+            const ClassSummary& classInfo = *sorted[index];
+            std::string qualifiedName = classInfo.qualifiedName.empty() ? classInfo.name : classInfo.qualifiedName;
+            file << "    {ReflectionRuntime::HashName(\"" << qualifiedName << "\"), " << getInterval(index) << "},\n";
+        }
+        file << "};\n\n";
+    }
+    file << "} // namespace Core\n";
+    file << "} // namespace Engine\n";
+    
+    file << "\n#endif // " << guard << "\n";
+    file.close();
+}
+
+size_t CodeGenerator::FindBaseClass(const std::vector<const ClassSummary*>& classes, const ClassSummary& classInfo) {
+    std::string baseClass = classInfo.baseClass;
+    if (baseClass.rfind("::", 0) == 0) {
+        baseClass = baseClass.substr(2);
+    }
+    if (baseClass.empty()) {
+        return classes.size();
+    }
+    
+    // The base may be spelled relative to the namespace of the derived class
+    std::string scopedBase = classInfo.namespaceName.empty() ? baseClass : classInfo.namespaceName + "::" + baseClass;
+    for (size_t i = 0; i < classes.size(); ++i) {
+        const std::string& qualifiedName = classes[i]->qualifiedName.empty() ? classes[i]->name : classes[i]->qualifiedName;
+        if (qualifiedName == baseClass || qualifiedName == scopedBase || qualifiedName == classInfo.reflectedBase) {
+            return i;
+        }
+    }
+    return classes.size();
+}
+
+void CodeGenerator::WriteModuleTypeTable(std::ofstream& file, const std::vector<ClassSummary>& classes) {
+    // The registry looks types up by their unqualified name, so the table is sorted by it
+    std::vector<const ClassSummary*> sorted;
+    for (const auto& classInfo : classes) {
+        sorted.push_back(&classInfo);
+    }
+    std::sort(sorted.begin(), sorted.end(), [](const ClassSummary* a, const ClassSummary* b) {
+        if (a->name != b->name) return a->name < b->name;
+        return a->qualifiedName < b->qualifiedName;
+    });
+    
+    if (!sorted.empty()) {
+        file << "namespace {\n\n";
+        file << "// Sorted by name for binary search\n";
+        file << "constexpr ReflectionRuntime::TypeRegistration kModuleTypes[] = {\n";
+        for (const auto* classInfo : sorted) {
+            std::string qualifier = classInfo->namespaceName.empty() ? "::" : "::" + classInfo->namespaceName + "::";
+            file << "    {\"" << classInfo->name << "\", " << qualifier << "k" << classInfo->name << "TypeId, &"
+                 << qualifier << "Register" << classInfo->name << "Type},\n";
+        }
+        file << "};\n\n";
+        file << "} // namespace\n\n";
+    }
+    
+    // Constructed on first use, so loading the module runs no code
+    file << "ReflectionRuntime::TypeTable& Get" << m_moduleName << "ReflectionTable() {\n";
+    if (sorted.empty()) {
+        file << "    static ReflectionRuntime::TypeTable table({});\n";
+    } else {
+        file << "    static ReflectionRuntime::TypeTable table(kModuleTypes);\n";
+    }
+    file << "    return table;\n";
+    file << "}\n\n";
+    
+    file << "void Register" << m_moduleName << "ReflectionTypes() {\n";
+    file << "    Get" << m_moduleName << "ReflectionTable().RegisterAll();\n";
+    file << "}\n\n";
+    
+    // Opt-in eager mode: a single static initializer for the whole module. The type is
+    // module-local, every module defines one.
+    file << "#ifdef REFLECTION_EAGER_REGISTRATION\n";
+    file << "namespace {\n";
+    file << "struct ModuleReflectionRegistration {\n";
+    file << "    ModuleReflectionRegistration() {\n";
+    file << "        Register" << m_moduleName << "ReflectionTypes();\n";
+    file << "    }\n";
+    file << "} g_ModuleReflectionRegistration;\n";
+    file << "} // namespace\n";
+    file << "#endif\n\n";
+}
+
+std::string CodeGenerator::GetFlavorName(GenerationFlavor flavor) {
+    switch (flavor) {
+        case GenerationFlavor::Editor: return "editor";
+        case GenerationFlavor::Runtime: return "runtime";
+        default: return "default";
+    }
+}
+
+bool CodeGenerator::ParseFlavorName(const std::string& name, GenerationFlavor& flavor) {
+    if (name == "editor") {
+        flavor = GenerationFlavor::Editor;
+        return true;
+    }
+    if (name == "runtime") {
+        flavor = GenerationFlavor::Runtime;
+        return true;
+    }
+    return false;
+}
+
+std::string CodeGenerator::GetDefaultModuleName(const std::string& outputDir) {
+    std::filesystem::path path = std::filesystem::path(outputDir).lexically_normal();
+    if (path.filename().empty()) {
+        path = path.parent_path();
+    }
+    
+    // PascalCase like the rest of the generated names, anything else becomes an underscore
+    std::string name = path.filename().string();
+    for (char& c : name) {
+        if (!std::isalnum(static_cast<unsigned char>(c))) {
+            c = '_';
+        }
+    }
+    if (name.empty() || std::isdigit(static_cast<unsigned char>(name[0]))) {
+        name = "Module" + name;
+    }
+    name[0] = static_cast<char>(std::toupper(static_cast<unsigned char>(name[0])));
+    return name;
+}
+
 std::string CodeGenerator::GetOutputPath(const std::string& filePath, const std::string& suffix) {
     std::filesystem::path sourcePath(filePath);
     std::string fileName = sourcePath.stem().string();
@@ -146,11 +534,32 @@ void CodeGenerator::WriteHeaderPreamble(std::ofstream& file, const ClassInfo& cl
 }
 
 void CodeGenerator::WriteHeaderIncludes(std::ofstream& file, const ClassInfo& classInfo) {
+    if (m_options.leanIncludes) {
+        // The header only declares functions over a forward-declared class and the
+        // member indices, so it needs std::unique_ptr, uint16_t and std::string_view
+        file << "#include <cstdint>\n";
+        file << "#include <memory>\n";
+        file << "#include <string_view>\n";
+        file << "#include \"ReflectionRuntime/NameHash.h\"\n";
+        if (classInfo.allocation != AllocationMode::Heap) {
+            file << "#include \"ReflectionRuntime/Pool.h\"\n";
+        }
+        file << "\n";
+        return;
+    }
+    
     file << "#include \"Core/GObject.h\"\n";
     file << "#include \"Core/TypeRegistry.h\"\n";
     file << "#include \"Core/BinarySerializer.h\"\n";
+    file << "#include <cstdint>\n";
     file << "#include <string>\n";
-    file << "#include <memory>\n\n";
+    file << "#include <string_view>\n";
+    file << "#include <memory>\n";
+    file << "#include \"ReflectionRuntime/NameHash.h\"\n";
+    if (classInfo.allocation != AllocationMode::Heap) {
+        file << "#include \"ReflectionRuntime/Pool.h\"\n";
+    }
+    file << "\n";
 }
 
 void CodeGenerator::WriteHeaderClass(std::ofstream& file, const ClassInfo& classInfo) {
@@ -158,14 +567,81 @@ void CodeGenerator::WriteHeaderClass(std::ofstream& file, const ClassInfo& class
     
     file << "class " << classInfo.name << ";\n\n";
     
+    // Found by ADL through ReflectionRuntime::kTypeId
+    std::string qualifiedName = classInfo.qualifiedName.empty() ? classInfo.name : classInfo.qualifiedName;
+    file << "// Stable id of " << classInfo.name << ", the hash of its qualified name\n";
+    file << "inline constexpr uint64_t k" << classInfo.name << "TypeId = ReflectionRuntime::HashName(\""
+         << qualifiedName << "\");\n";
+    file << "constexpr uint64_t GetReflectedTypeId(const " << classInfo.name << "*) noexcept { return k"
+         << classInfo.name << "TypeId; }\n\n";
+    
     // Forward declarations for generated functions
     file << "// Generated reflection functions\n";
     file << "void Register" << classInfo.name << "Type();\n";
-    file << "std::unique_ptr<" << classInfo.name << "> Create" << classInfo.name << "Instance();\n\n";
+    WriteHeaderFactory(file, classInfo);
+    
+    WriteHeaderMemberIndices(file, classInfo);
     
     file << GetNamespaceSuffix(classInfo.namespaceName);
 }
 
+void CodeGenerator::WriteHeaderFactory(std::ofstream& file, const ClassInfo& classInfo) {
+    const std::string& name = classInfo.name;
+    if (classInfo.allocation == AllocationMode::Heap) {
+        file << "using " << name << "InstancePtr = std::unique_ptr<" << name << ">;\n";
+        file << name << "InstancePtr Create" << name << "Instance();\n\n";
+        return;
+    }
+    
+    // The deleter hands the memory back to the pool, it is empty so the pointer stays small
+    file << "using " << name << "InstancePtr = std::unique_ptr<" << name << ", ReflectionRuntime::PoolDeleter<"
+         << GetPoolArguments(classInfo) << ">>;\n";
+    file << name << "InstancePtr Create" << name << "Instance();\n";
+    file << "ReflectionRuntime::AllocationStats& Get" << name << "AllocationStats() noexcept;\n";
+    if (classInfo.allocation == AllocationMode::Arena) {
+        file << "bool Reset" << name << "Arena();\n";
+    }
+    file << "\n";
+}
+
+std::string CodeGenerator::GetPoolArguments(const ClassInfo& classInfo) {
+    return classInfo.name + (classInfo.allocation == AllocationMode::Arena ? ", false" : "");
+}
+
+void CodeGenerator::WriteHeaderMemberIndices(std::ofstream& file, const ClassInfo& classInfo) {
+    const std::string& name = classInfo.name;
+    std::vector<std::string> propertyNames = GetMemberNames(GetIncludedProperties(classInfo));
+    std::vector<std::string> functionNames = GetMemberNames(classInfo.functions);
+    
+    // Indices follow registration order, so they address GType and TypeDescriptor members directly
+    file << "// Indices of the reflected members of " << name << ", in registration order\n";
+    file << "namespace " << name << "PropertyIndex {\n";
+    file << "    enum : uint16_t {\n";
+    for (size_t i = 0; i < propertyNames.size(); ++i) {
+        if (std::find(propertyNames.begin(), propertyNames.begin() + i, propertyNames[i]) == propertyNames.begin() + i) {
+            file << "        " << propertyNames[i] << " = " << i << ",\n";
+        }
+    }
+    file << "    };\n";
+    file << "}\n";
+    file << "namespace " << name << "FunctionIndex {\n";
+    file << "    enum : uint16_t {\n";
+    for (size_t i = 0; i < functionNames.size(); ++i) {
+        // Overloads share the index of the first declaration
+        if (std::find(functionNames.begin(), functionNames.begin() + i, functionNames[i]) == functionNames.begin() + i) {
+            file << "        " << functionNames[i] << " = " << i << ",\n";
+        }
+    }
+    file << "    };\n";
+    file << "}\n";
+    file << "inline constexpr uint16_t k" << name << "PropertyCount = " << propertyNames.size() << ";\n";
+    file << "inline constexpr uint16_t k" << name << "FunctionCount = " << functionNames.size() << ";\n\n";
+    
+    file << "// Perfect hash lookups, -1 if there is no member with that name\n";
+    file << "int Find" << name << "PropertyIndex(std::string_view name) noexcept;\n";
+    file << "int Find" << name << "FunctionIndex(std::string_view name) noexcept;\n\n";
+}
+
 void CodeGenerator::WriteHeaderEpilogue(std::ofstream& file, const ClassInfo& classInfo) {
     file << "\n#endif // " << GetIncludeGuard(classInfo.name) << "\n";
 }
@@ -177,41 +653,68 @@ void CodeGenerator::WriteImplementationPreamble(std::ofstream& file, const Class
 }
 
 void CodeGenerator::WriteImplementationIncludes(std::ofstream& file, const ClassInfo& classInfo) {
-    file << "#include \"" << classInfo.name << ".generated.h\"\n";
+    // Same name GenerateCode gives the header, which is prefixed with the source file
+    std::string headerPath = GetOutputPath(classInfo.fileName, classInfo.name + ".generated.h");
+    file << "#include \"" << std::filesystem::path(headerPath).filename().string() << "\"\n";
+    
+    if (m_options.leanIncludes) {
+        // The class definition brings GObject and everything its members need
+        if (!classInfo.fileName.empty()) {
+            file << "#include \"" << GetRelativePath(headerPath, classInfo.fileName) << "\"\n";
+        }
+        
+        // GType, GProperty and GFunction for the registration function. It also
+        // declares the std::type_info based constructor, so <typeinfo> comes with it.
+        file << "#include \"Core/TypeRegistry.h\"\n";
+        
+        if (HasSerializedProperties(classInfo)) {
+            file << "#include \"Core/BinarySerializer.h\"\n";
+            file << "#include \"ReflectionRuntime/SerializedSize.h\"\n";
+        }
+        if (!classInfo.properties.empty()) {
+            file << "#include <cstddef>\n";
+        }
+        if (m_options.staticDescriptors) {
+            file << "#include \"ReflectionRuntime/TypeDescriptor.h\"\n";
+        } else {
+            file << "#include \"ReflectionRuntime/NameIndex.h\"\n";
+            if (!classInfo.functions.empty()) {
+                file << "#include \"ReflectionRuntime/Invoke.h\"\n";
+            }
+        }
+        file << "\n";
+        return;
+    }
+    
     file << "#include \"Core/GObject.h\"\n";
     file << "#include \"Core/TypeRegistry.h\"\n";
     file << "#include \"Core/BinarySerializer.h\"\n";
+    file << "#include \"ReflectionRuntime/SerializedSize.h\"\n";
+    if (m_options.staticDescriptors) {
+        file << "#include \"ReflectionRuntime/TypeDescriptor.h\"\n";
+    } else {
+        file << "#include \"ReflectionRuntime/Invoke.h\"\n";
+        file << "#include \"ReflectionRuntime/NameIndex.h\"\n";
+    }
     file << "#include <typeinfo>\n\n";
 }
 
 void CodeGenerator::WriteImplementationClass(std::ofstream& file, const ClassInfo& classInfo) {
     file << GetNamespacePrefix(classInfo.namespaceName);
     
-    // Write type registration function
-    file << "void Register" << classInfo.name << "Type() {\n";
-    file << "    auto type = std::make_unique<GType>(\n";
-    file << "        \"" << classInfo.name << "\",\n";
-    file << "        typeid(" << classInfo.name << "),\n";
-    file << "        sizeof(" << classInfo.name << ")\n";
-    file << "    );\n\n";
-    
-    // Register properties
-    for (const auto& property : classInfo.properties) {
-        WritePropertyRegistration(file, property);
-    }
+    WriteNameIndices(file, classInfo);
     
-    // Register functions
-    for (const auto& function : classInfo.functions) {
-        WriteFunctionRegistration(file, function);
+    if (m_options.staticDescriptors) {
+        // Registration only hands the read-only descriptor to the registry
+        WriteStaticDescriptors(file, classInfo);
+        file << "void Register" << classInfo.name << "Type() {\n";
+        file << "    TypeRegistry::GetInstance().RegisterType(k" << classInfo.name << "TypeDescriptor);\n";
+        file << "}\n\n";
+    } else {
+        WriteRegistrationFunction(file, classInfo);
     }
     
-    file << "    TypeRegistry::GetInstance().RegisterType(std::move(type));\n";
-    file << "}\n\n";
-    
-    // Write factory function
-    file << "std::unique_ptr<" << classInfo.name << "> Create" << classInfo.name << "Instance() {\n";
-    file << "    return std::make_unique<" << classInfo.name << ">();\n";
-    file << "}\n\n";
+    WriteFactoryFunctions(file, classInfo);
     
     // Write serialization code
     WriteSerializationCode(file, classInfo);
@@ -220,84 +723,1191 @@ void CodeGenerator::WriteImplementationClass(std::ofstream& file, const ClassInf
     file << GetNamespaceSuffix(classInfo.namespaceName);
 }
 
-void CodeGenerator::WriteImplementationEpilogue(std::ofstream& file, const ClassInfo& classInfo) {
-    // Static registration
-    file << "\n// Static registration\n";
-    file << "static struct " << classInfo.name << "Registration {\n";
-    file << "    " << classInfo.name << "Registration() {\n";
-    file << "        Register" << classInfo.name << "Type();\n";
-    file << "    }\n";
-    file << "} g_" << classInfo.name << "Registration;\n";
-}
-
-void CodeGenerator::WritePropertyRegistration(std::ofstream& file, const PropertyInfo& property) {
-    file << "    // Property: " << property.name << "\n";
-    file << "    auto " << property.name << "Property = std::make_unique<GProperty>(\n";
-    file << "        \"" << property.name << "\",\n";
-    file << "        nullptr, // Type will be set by generator\n";
-    file << "        offsetof(" << property.type << ", " << property.name << "),\n";
-    file << "        " << GetPropertyFlagsString(property) << "\n";
-    file << "    );\n";
-    file << "    type->AddProperty(std::move(" << property.name << "Property));\n\n";
+void CodeGenerator::WriteFactoryFunctions(std::ofstream& file, const ClassInfo& classInfo) {
+    const std::string& name = classInfo.name;
+    file << name << "InstancePtr Create" << name << "Instance() {\n";
+    if (classInfo.allocation == AllocationMode::Heap) {
+        file << "    return std::make_unique<" << name << ">();\n";
+        file << "}\n\n";
+        return;
+    }
+    
+    std::string pool = "ReflectionRuntime::ObjectPool<" + GetPoolArguments(classInfo) + ">";
+    file << "    return " << name << "InstancePtr(ReflectionRuntime::CreatePooled<" << GetPoolArguments(classInfo) << ">());\n";
+    file << "}\n\n";
+    file << "ReflectionRuntime::AllocationStats& Get" << name << "AllocationStats() noexcept {\n";
+    file << "    return " << pool << "::GetStats();\n";
+    file << "}\n\n";
+    if (classInfo.allocation == AllocationMode::Arena) {
+        file << "bool Reset" << name << "Arena() {\n";
+        file << "    return " << pool << "::Reset();\n";
+        file << "}\n\n";
+    }
 }
 
-void CodeGenerator::WriteFunctionRegistration(std::ofstream& file, const FunctionInfo& function) {
-    file << "    // Function: " << function.name << "\n";
-    file << "    auto " << function.name << "Function = std::make_unique<GFunction>(\n";
-    file << "        \"" << function.name << "\",\n";
-    file << "        nullptr, // Function pointer will be set by generator\n";
-    file << "        " << GetFunctionFlagsString(function) << "\n";
-    file << "    );\n";
-    file << "    type->AddFunction(std::move(" << function.name << "Function));\n\n";
+void CodeGenerator::WriteNameIndices(std::ofstream& file, const ClassInfo& classInfo) {
+    const std::string& name = classInfo.name;
+    WriteNameIndex(file, "k" + name + "Property", GetMemberNames(GetIncludedProperties(classInfo)));
+    WriteNameIndex(file, "k" + name + "Function", GetMemberNames(classInfo.functions));
+    
+    file << "int Find" << name << "PropertyIndex(std::string_view name) noexcept {\n";
+    file << "    return k" << name << "PropertyIndex.Find(name);\n";
+    file << "}\n\n";
+    file << "int Find" << name << "FunctionIndex(std::string_view name) noexcept {\n";
+    file << "    return k" << name << "FunctionIndex.Find(name);\n";
+    file << "}\n\n";
 }
 
-void CodeGenerator::WriteSerializationCode(std::ofstream& file, const ClassInfo& classInfo) {
-    file << "// Serialization implementation for " << classInfo.name << "\n";
-    file << "void " << classInfo.name << "::Serialize(BinarySerializer& serializer) const {\n";
-    file << "    // Call base class serialization\n";
-    if (!classInfo.baseClass.empty()) {
-        file << "    " << classInfo.baseClass << "::Serialize(serializer);\n";
+void CodeGenerator::WriteNameIndex(std::ofstream& file, const std::string& prefix, const std::vector<std::string>& names) {
+    // Overloaded functions are found through their first declaration
+    std::vector<std::string> keys;
+    std::vector<uint16_t> keyIndices;
+    for (size_t i = 0; i < names.size(); ++i) {
+        if (std::find(keys.begin(), keys.end(), names[i]) == keys.end()) {
+            keys.push_back(names[i]);
+            keyIndices.push_back(static_cast<uint16_t>(i));
+        }
     }
-    file << "    \n";
-    file << "    // Serialize properties\n";
     
-    for (const auto& property : classInfo.properties) {
-        if (property.save && !property.transient) {
-            file << "    if (auto* prop = GetType()->GetProperty(\"" << property.name << "\")) {\n";
-            file << "        void* propPtr = prop->GetPropertyPtr(const_cast<" << classInfo.name << "*>(this));\n";
-            file << "        // Serialize property based on type\n";
-            file << "        // This will be expanded by the generator based on property type\n";
-            file << "    }\n";
-        }
+    if (keys.empty()) {
+        file << "constexpr ReflectionRuntime::NameIndex " << prefix << "Index{};\n\n";
+        return;
     }
     
-    file << "}\n\n";
-}
-
-void CodeGenerator::WriteDeserializationCode(std::ofstream& file, const ClassInfo& classInfo) {
-    file << "// Deserialization implementation for " << classInfo.name << "\n";
-    file << "void " << classInfo.name << "::Deserialize(BinaryDeserializer& deserializer) {\n";
-    file << "    // Call base class deserialization\n";
-    if (!classInfo.baseClass.empty()) {
-        file << "    " << classInfo.baseClass << "::Deserialize(deserializer);\n";
+    PerfectHashTable table;
+    bool hashed = PerfectHash::Build(keys, table);
+    if (!hashed) {
+        // NameIndex searches linearly without displacements
+        std::cerr << "Warning: Cannot build a perfect hash for " << prefix << ", using a linear lookup\n";
+        table.slots.resize(keys.size());
+        for (size_t i = 0; i < keys.size(); ++i) {
+            table.slots[i] = static_cast<uint16_t>(i);
+        }
     }
-    file << "    \n";
-    file << "    // Deserialize properties\n";
     
-    for (const auto& property : classInfo.properties) {
-        if (property.save && !property.transient) {
-            file << "    if (auto* prop = GetType()->GetProperty(\"" << property.name << "\")) {\n";
-            file << "        void* propPtr = prop->GetPropertyPtr(this);\n";
-            file << "        // Deserialize property based on type\n";
-            file << "        // This will be expanded by the generator based on property type\n";
-            file << "    }\n";
+    file << "namespace {\n\n";
+    if (hashed) {
+        file << "constexpr int32_t " << prefix << "Displacements[] = {";
+        for (size_t i = 0; i < table.displacements.size(); ++i) {
+            file << (i > 0 ? ", " : "") << table.displacements[i];
         }
+        file << "};\n";
     }
+    file << "constexpr std::string_view " << prefix << "SlotNames[] = {";
+    for (size_t i = 0; i < table.slots.size(); ++i) {
+        file << (i > 0 ? ", " : "") << "\"" << keys[table.slots[i]] << "\"";
+    }
+    file << "};\n";
+    file << "constexpr uint16_t " << prefix << "SlotIndices[] = {";
+    for (size_t i = 0; i < table.slots.size(); ++i) {
+        file << (i > 0 ? ", " : "") << keyIndices[table.slots[i]];
+    }
+    file << "};\n\n";
+    file << "} // namespace\n\n";
     
-    file << "}\n\n";
+    file << "constexpr ReflectionRuntime::NameIndex " << prefix << "Index{"
+         << (hashed ? prefix + "Displacements" : "{}") << ", "
+         << prefix << "SlotNames, " << prefix << "SlotIndices};\n\n";
 }
 
-std::string CodeGenerator::GetPropertyFlagsString(const PropertyInfo& property) {
+std::vector<const PropertyInfo*> CodeGenerator::GetIncludedProperties(const ClassInfo& classInfo) {
+    std::vector<const PropertyInfo*> properties;
+    for (const auto& property : classInfo.properties) {
+        if (IsPropertyIncluded(property)) {
+            properties.push_back(&property);
+        }
+    }
+    return properties;
+}
+
+std::vector<std::string> CodeGenerator::GetMemberNames(const std::vector<const PropertyInfo*>& properties) {
+    std::vector<std::string> names;
+    for (const auto* property : properties) {
+        names.push_back(property->name);
+    }
+    return names;
+}
+
+std::vector<std::string> CodeGenerator::GetMemberNames(const std::vector<FunctionInfo>& functions) {
+    std::vector<std::string> names;
+    for (const auto& function : functions) {
+        names.push_back(function.name);
+    }
+    return names;
+}
+
+void CodeGenerator::WriteStaticDescriptors(std::ofstream& file, const ClassInfo& classInfo) {
+    const std::string& name = classInfo.name;
+    bool editorMetadata = m_options.flavor == GenerationFlavor::Editor;
+    
+    std::vector<const PropertyInfo*> properties = GetIncludedProperties(classInfo);
+    
+    file << "// Read-only type description of " << name << "\n";
+    file << "namespace {\n\n";
+    
+    if (!properties.empty()) {
+        file << "constexpr ReflectionRuntime::PropertyDescriptor k" << name << "Properties[] = {\n";
+        for (const auto* property : properties) {
+            file << "    {\"" << property->name << "\", "
+                 << "offsetof(" << name << ", " << property->name << "), "
+                 << "sizeof(" << name << "::" << property->name << "), "
+                 << GetDescriptorFlagsString(*property) << ", "
+                 << "ReflectionRuntime::HashName(\"" << property->type << "\")},\n";
+        }
+        file << "};\n\n";
+        
+        if (editorMetadata) {
+            file << "constexpr ReflectionRuntime::MetadataDescriptor k" << name << "PropertyMetadata[] = {\n";
+            for (const auto* property : properties) {
+                file << "    {\"" << property->category << "\", \"" << property->tooltip << "\"},\n";
+            }
+            file << "};\n\n";
+        }
+    }
+    
+    if (!classInfo.functions.empty()) {
+        file << "constexpr ReflectionRuntime::FunctionDescriptor k" << name << "Functions[] = {\n";
+        for (const auto& function : classInfo.functions) {
+            file << "    {\"" << function.name << "\", " << GetDescriptorFlagsString(function) << ", "
+                 << GetInvokeThunk(classInfo, function) << ", " << function.parameters.size() << "},\n";
+        }
+        file << "};\n\n";
+        
+        if (editorMetadata) {
+            file << "constexpr ReflectionRuntime::MetadataDescriptor k" << name << "FunctionMetadata[] = {\n";
+            for (const auto& function : classInfo.functions) {
+                file << "    {\"" << function.category << "\", \"" << function.tooltip << "\"},\n";
+            }
+            file << "};\n\n";
+        }
+    }
+    
+    file << "} // namespace\n\n";
+    
+    file << "constexpr ReflectionRuntime::TypeDescriptor k" << name << "TypeDescriptor{\n";
+    file << "    \"" << name << "\",\n";
+    file << "    k" << name << "TypeId,\n";
+    file << "    sizeof(" << name << "),\n";
+    file << "    alignof(" << name << "),\n";
+    file << "    " << (properties.empty() ? "{}" : "k" + name + "Properties") << ",\n";
+    file << "    " << (classInfo.functions.empty() ? "{}" : "k" + name + "Functions") << ",\n";
+    file << "    " << (editorMetadata && !properties.empty() ? "k" + name + "PropertyMetadata" : "{}") << ",\n";
+    file << "    " << (editorMetadata && !classInfo.functions.empty() ? "k" + name + "FunctionMetadata" : "{}") << ",\n";
+    file << "    k" << name << "PropertyIndex,\n";
+    file << "    k" << name << "FunctionIndex\n";
+    file << "};\n\n";
+}
+
+void CodeGenerator::WriteRegistrationFunction(std::ofstream& file, const ClassInfo& classInfo) {
+    // Write type registration function
+    file << "void Register" << classInfo.name << "Type() {\n";
+    file << "    auto type = std::make_unique<GType>(\n";
+    file << "        \"" << classInfo.name << "\",\n";
+    file << "        typeid(" << classInfo.name << "),\n";
+    file << "        sizeof(" << classInfo.name << ")\n";
+    file << "    );\n\n";
+    
+    // Register properties
+    for (const auto& property : classInfo.properties) {
+        if (IsPropertyIncluded(property)) {
+            WritePropertyRegistration(file, property);
+        }
+    }
+    
+    // Register functions
+    for (size_t i = 0; i < classInfo.functions.size(); ++i) {
+        WriteFunctionRegistration(file, classInfo, classInfo.functions[i], i);
+    }
+    
+    file << "    ReflectionRuntime::AttachNameIndex(*type, k" << classInfo.name << "PropertyIndex, k" << classInfo.name
+         << "FunctionIndex);\n";
+    file << "    TypeRegistry::GetInstance().RegisterType(std::move(type));\n";
+    file << "}\n\n";
+}
+
+void CodeGenerator::WriteImplementationEpilogue(std::ofstream& file, const ClassInfo& classInfo) {
+    // Lazy registration goes through the module's type table
+    if (m_options.lazyRegistration) {
+        return;
+    }
+    
+    // Static registration
+    file << "\n// Static registration\n";
+    file << "static struct " << classInfo.name << "Registration {\n";
+    file << "    " << classInfo.name << "Registration() {\n";
+    file << "        Register" << classInfo.name << "Type();\n";
+    file << "    }\n";
+    file << "} g_" << classInfo.name << "Registration;\n";
+}
+
+void CodeGenerator::WritePropertyRegistration(std::ofstream& file, const PropertyInfo& property) {
+    file << "    // Property: " << property.name << "\n";
+    file << "    auto " << property.name << "Property = std::make_unique<GProperty>(\n";
+    file << "        \"" << property.name << "\",\n";
+    file << "        nullptr, // Type will be set by generator\n";
+    file << "        offsetof(" << property.type << ", " << property.name << "),\n";
+    file << "        " << GetPropertyFlagsString(property) << "\n";
+    file << "    );\n";
+    WriteMetadata(file, property.name + "Property", property.category, property.tooltip);
+    file << "    type->AddProperty(std::move(" << property.name << "Property));\n\n";
+}
+
+void CodeGenerator::WriteFunctionRegistration(std::ofstream& file, const ClassInfo& classInfo, const FunctionInfo& function,
+                                              size_t index) {
+    // Overloads share the name, the index keeps their variables apart
+    std::string variable = function.name + "Function" + std::to_string(index);
+    file << "    // Function: " << function.name << "\n";
+    file << "    auto " << variable << " = std::make_unique<GFunction>(\n";
+    file << "        \"" << function.name << "\",\n";
+    file << "        " << GetInvokeThunk(classInfo, function) << ",\n";
+    file << "        " << GetFunctionFlagsString(function) << "\n";
+    file << "    );\n";
+    WriteMetadata(file, variable, function.category, function.tooltip);
+    file << "    type->AddFunction(std::move(" << variable << "));\n\n";
+}
+
+std::string CodeGenerator::GetInvokeThunk(const ClassInfo& classInfo, const FunctionInfo& function) {
+    std::string pointer = "&" + classInfo.name + "::" + function.name;
+    
+    // An overloaded name needs the exact signature to pick one function
+    size_t overloads = std::count_if(classInfo.functions.begin(), classInfo.functions.end(),
+                                     [&](const FunctionInfo& other) { return other.name == function.name; });
+    if (overloads > 1 && !function.pointerType.empty()) {
+        pointer = "static_cast<" + function.pointerType + ">(" + pointer + ")";
+    }
+    return "ReflectionRuntime::InvokeThunk<" + pointer + ">";
+}
+
+void CodeGenerator::WriteMetadata(std::ofstream& file, const std::string& variable,
+                                  const std::string& category, const std::string& tooltip) {
+    // Category and tooltip only matter to the editor
+    if (m_options.flavor != GenerationFlavor::Editor) {
+        return;
+    }
+    
+    if (!category.empty()) {
+        file << "    " << variable << "->SetMetadata(\"Category\", \"" << category << "\");\n";
+    }
+    if (!tooltip.empty()) {
+        file << "    " << variable << "->SetMetadata(\"Tooltip\", \"" << tooltip << "\");\n";
+    }
+}
+
+void CodeGenerator::WriteSchema(std::ofstream& file, const ClassInfo& classInfo) {
+    const std::string& name = classInfo.name;
+    file << "// Schema of the serialized properties: name and type of each, in order\n";
+    file << "namespace {\n";
+    file << "constexpr ReflectionRuntime::SchemaField k" << name << "Schema[] = {\n";
+    for (const auto* property : GetSerializedProperties(classInfo)) {
+        file << "    {ReflectionRuntime::HashName(\"" << property->name << "\"), ReflectionRuntime::HashName(\""
+             << property->type << "\")},\n";
+    }
+    file << "};\n\n";
+    file << "constexpr uint64_t k" << name << "SchemaFingerprint = ReflectionRuntime::SchemaFingerprint(k"
+         << name << "Schema, " << classInfo.version << ");\n";
+    file << "} // namespace\n\n";
+}
+
+void CodeGenerator::WriteSerializationCode(std::ofstream& file, const ClassInfo& classInfo) {
+    bool hasSchema = HasSerializedProperties(classInfo);
+    if (hasSchema) {
+        WriteSchema(file, classInfo);
+    }
+    
+    file << "// Serialization implementation for " << classInfo.name << "\n";
+    file << "void " << classInfo.name << "::Serialize(BinarySerializer& serializer) const {\n";
+    file << "    // Call base class serialization\n";
+    if (!classInfo.baseClass.empty()) {
+        file << "    " << classInfo.baseClass << "::Serialize(serializer);\n";
+    }
+    file << "    \n";
+    
+    if (hasSchema && classInfo.tagged) {
+        file << "    // Schema header with field table, so data written by another version of the class can still be read\n";
+        file << "    const uint32_t fieldSizes[] = {\n";
+        for (const auto* property : GetSerializedProperties(classInfo)) {
+            file << "        ReflectionRuntime::GetSchemaFieldSize(" << property->name << "),\n";
+        }
+        file << "    };\n";
+        file << "    ReflectionRuntime::WriteSchemaTable(serializer, k" << classInfo.name << "SchemaFingerprint, k"
+             << classInfo.name << "Schema, fieldSizes);\n";
+        file << "    \n";
+    } else if (hasSchema) {
+        file << "    // Schema header, so data written by another version of the class is recognized and skipped\n";
+        file << "    ReflectionRuntime::WriteSchemaHeader(serializer, k" << classInfo.name
+             << "SchemaFingerprint, ReflectionRuntime::GetSchemaPayloadSize(";
+        std::vector<const PropertyInfo*> properties = GetSerializedProperties(classInfo);
+        for (size_t i = 0; i < properties.size(); ++i) {
+            file << (i > 0 ? ", " : "") << properties[i]->name;
+        }
+        file << "));\n";
+        file << "    \n";
+    }
+    
+    file << "    // Serialize properties\n";
+    for (const auto& run : GetSerializationRuns(classInfo)) {
+        if (run.size() == 1) {
+            file << "    ReflectionRuntime::Write(serializer, " << run.front()->name << ");\n";
+            continue;
+        }
+        
+        file << "    if constexpr (" << GetRunCondition(classInfo, run) << ") {\n";
+        file << "        serializer.WriteBytes(reinterpret_cast<const char*>(this) + offsetof(" << classInfo.name
+             << ", " << run.front()->name << "), " << GetRunSize(classInfo, run) << ");\n";
+        file << "    } else {\n";
+        for (const auto* property : run) {
+            file << "        ReflectionRuntime::Write(serializer, " << property->name << ");\n";
+        }
+        file << "    }\n";
+    }
+    
+    file << "}\n\n";
+}
+
+void CodeGenerator::WriteDeserializationCode(std::ofstream& file, const ClassInfo& classInfo) {
+    file << "// Deserialization implementation for " << classInfo.name << "\n";
+    file << "void " << classInfo.name << "::Deserialize(BinaryDeserializer& deserializer) {\n";
+    file << "    // Call base class deserialization\n";
+    if (!classInfo.baseClass.empty()) {
+        file << "    " << classInfo.baseClass << "::Deserialize(deserializer);\n";
+    }
+    file << "    \n";
+    
+    if (!HasSerializedProperties(classInfo)) {
+        file << "}\n\n";
+        return;
+    }
+    
+    // Fast path: the data was written with this exact schema
+    std::vector<const PropertyInfo*> properties = GetSerializedProperties(classInfo);
+    file << "    // Deserialize properties directly if the data has this schema\n";
+    file << "    ReflectionRuntime::SchemaMatch match = ReflectionRuntime::ReadSchemaHeader(deserializer, k"
+         << classInfo.name << "SchemaFingerprint, " << properties.size() << ");\n";
+    file << "    if (match == ReflectionRuntime::SchemaMatch::Direct) {\n";
+    for (const auto& run : GetSerializationRuns(classInfo)) {
+        if (run.size() == 1) {
+            file << "        ReflectionRuntime::Read(deserializer, " << run.front()->name << ");\n";
+            continue;
+        }
+        
+        file << "        if constexpr (" << GetRunCondition(classInfo, run, 4) << ") {\n";
+        file << "            deserializer.ReadBytes(reinterpret_cast<char*>(this) + offsetof(" << classInfo.name
+             << ", " << run.front()->name << "), " << GetRunSize(classInfo, run) << ");\n";
+        file << "        } else {\n";
+        for (const auto* property : run) {
+            file << "            ReflectionRuntime::Read(deserializer, " << property->name << ");\n";
+        }
+        file << "        }\n";
+    }
+    file << "        return;\n";
+    file << "    }\n";
+    file << "    \n";
+    
+    // Slow path, only data written with a field table has one. Without it the stored
+    // properties have been skipped, so only the failure is left to report.
+    file << "    if (match == ReflectionRuntime::SchemaMatch::Unreadable) {\n";
+    file << "        ReflectionRuntime::FailSchema(deserializer);\n";
+    file << "        return;\n";
+    file << "    }\n";
+    file << "    \n";
+    file << "    // Otherwise match the stored fields by name and type. Fields this class no longer has\n";
+    file << "    // are skipped, fields missing from the data keep their default value.\n";
+    file << "    for (const auto& entry : ReflectionRuntime::ReadSchemaTable(deserializer)) {\n";
+    file << "        switch (ReflectionRuntime::FindSchemaField(k" << classInfo.name << "Schema, entry)) {\n";
+    for (size_t i = 0; i < properties.size(); ++i) {
+        file << "        case " << i << ": ReflectionRuntime::Read(deserializer, " << properties[i]->name << "); break;\n";
+    }
+    file << "        default:\n";
+    file << "            if (!ReflectionRuntime::SkipSchemaField(deserializer, entry)) {\n";
+    file << "                return;\n";
+    file << "            }\n";
+    file << "            break;\n";
+    file << "        }\n";
+    file << "    }\n";
+    file << "}\n\n";
+}
+
+std::vector<std::vector<const PropertyInfo*>> CodeGenerator::GetSerializationRuns(const ClassInfo& classInfo) {
+    // Serialized properties in declaration order, adjacent bulk-copyable ones without
+    // padding in between grouped into one run
+    std::vector<std::vector<const PropertyInfo*>> runs;
+    const PropertyInfo* previous = nullptr;
+    
+    for (const auto& property : classInfo.properties) {
+        if (!IsPropertySerialized(property)) {
+            previous = nullptr;
+            continue;
+        }
+        
+        bool extendsRun = previous && previous->bulkCopyable && property.bulkCopyable &&
+                          property.offset == previous->offset + previous->size;
+        if (extendsRun) {
+            runs.back().push_back(&property);
+        } else {
+            runs.push_back({&property});
+        }
+        previous = &property;
+    }
+    
+    return runs;
+}
+
+std::string CodeGenerator::GetRunCondition(const ClassInfo& classInfo, const std::vector<const PropertyInfo*>& run,
+                                           size_t indent, const std::string& trait) {
+    // The run was found in the layout the generator saw, the compiler confirms it
+    // for the layout of the target being built
+    std::string continuation = " &&\n" + std::string(18 + indent, ' ');
+    std::stringstream condition;
+    condition << "ReflectionRuntime::kBulkCopy";
+    for (const auto* property : run) {
+        condition << continuation << "ReflectionRuntime::" << trait << "<decltype(" << classInfo.name << "::" << property->name << ")>";
+    }
+    for (size_t i = 1; i < run.size(); ++i) {
+        condition << continuation << "offsetof(" << classInfo.name << ", " << run[i]->name << ") == offsetof("
+                  << classInfo.name << ", " << run[i - 1]->name << ") + sizeof(" << classInfo.name << "::" << run[i - 1]->name << ")";
+    }
+    return condition.str();
+}
+
+std::string CodeGenerator::GetRunSize(const ClassInfo& classInfo, const std::vector<const PropertyInfo*>& run) {
+    return "offsetof(" + classInfo.name + ", " + run.back()->name + ") + sizeof(" + classInfo.name + "::" +
+           run.back()->name + ") - offsetof(" + classInfo.name + ", " + run.front()->name + ")";
+}
+
+std::string CodeGenerator::GetBaseCall(const ClassInfo& classInfo, const std::string& fallback,
+                                       const std::string& parameters, const std::string& call,
+                                       const std::string& objects) {
+    // The lambda's return type names the function, see ReflectionRuntime::CallBase
+    return "ReflectionRuntime::CallBase<" + classInfo.baseClass + ">(" + fallback + ", [&](" + parameters +
+           ") -> decltype(" + call + ") { return " + call + "; }" + (objects.empty() ? "" : ", " + objects) + ")";
+}
+
+void CodeGenerator::WritePropertyFields(std::ofstream& file, const ClassInfo& classInfo) {
+    const std::string& name = classInfo.name;
+    
+    std::vector<const PropertyInfo*> properties = GetIncludedProperties(classInfo);
+    
+    file << "// Compile-time property list of " << name << " after the ones of its base classes, used by\n";
+    file << "// ReflectionRuntime::ForEachProperty\n";
+    file << "constexpr auto GetReflectedProperties(const " << name << "*) noexcept {\n";
+    file << "    return std::tuple_cat(\n";
+    if (!classInfo.baseClass.empty()) {
+        file << "        " << GetBaseCall(classInfo, "std::tuple<>()", "const auto* base", "GetReflectedProperties(base)")
+             << ",\n";
+    }
+    file << "        std::make_tuple(\n";
+    for (size_t i = 0; i < properties.size(); ++i) {
+        file << "            ReflectionRuntime::PropertyField<&" << name << "::" << properties[i]->name << ", "
+             << GetDescriptorFlagsString(*properties[i]) << ">{\"" << properties[i]->name << "\"}"
+             << (i + 1 < properties.size() ? "," : "") << "\n";
+    }
+    file << "        ));\n";
+    file << "}\n\n";
+}
+
+void CodeGenerator::WriteViewClass(std::ofstream& file, const ClassInfo& classInfo) {
+    const std::string& name = classInfo.name;
+    std::vector<const PropertyInfo*> fixed;
+    std::vector<const PropertyInfo*> variable;
+    for (const auto* property : GetViewProperties(classInfo)) {
+        (IsFixedViewProperty(*property) ? fixed : variable).push_back(property);
+    }
+    
+    file << "/**\n";
+    file << " * Zero-copy read-only view over " << name << " data written by " << name << "View::Write.\n";
+    file << " * Fixed-size properties are read at constant offsets, strings and vectors through an\n";
+    file << " * offset table. Properties of other types are not part of the view format.\n";
+    file << " */\n";
+    file << "class " << name << "View {\n";
+    file << "public:\n";
+    
+    // Fixed section offsets, each one follows from the previous property's size
+    std::string previousOffset;
+    const PropertyInfo* previous = nullptr;
+    for (const auto* property : fixed) {
+        file << "    static constexpr size_t " << GetViewOffsetName(*property) << " = ";
+        if (previous) {
+            file << previousOffset << " + ReflectionRuntime::kViewFixedSize<decltype(" << name << "::" << previous->name << ")>;\n";
+        } else {
+            file << "0;\n";
+        }
+        previousOffset = GetViewOffsetName(*property);
+        previous = property;
+    }
+    file << "    static constexpr size_t kTableOffset = ";
+    if (previous) {
+        file << previousOffset << " + ReflectionRuntime::kViewFixedSize<decltype(" << name << "::" << previous->name << ")>;\n";
+    } else {
+        file << "0;\n";
+    }
+    file << "    static constexpr size_t kVariableCount = " << variable.size() << ";\n\n";
+    
+    file << "    explicit " << name << "View(std::span<const std::byte> buffer) noexcept\n";
+    file << "        : m_buffer(buffer) {}\n\n";
+    
+    file << "    // Accessors do not check bounds, validate untrusted buffers once with IsValid\n";
+    file << "    bool IsValid() const noexcept {\n";
+    file << "        return ReflectionRuntime::IsValidView<";
+    for (size_t i = 0; i < variable.size(); ++i) {
+        file << (i > 0 ? ", " : "") << "decltype(" << name << "::" << variable[i]->name << ")";
+    }
+    file << ">(m_buffer, kTableOffset);\n";
+    file << "    }\n\n";
+    
+    for (const auto* property : fixed) {
+        std::string type = "decltype(" + name + "::" + property->name + ")";
+        file << "    ReflectionRuntime::ViewFixedType<" << type << "> " << GetAccessorName(*property) << "() const noexcept {\n";
+        file << "        return ReflectionRuntime::ReadViewFixed<" << type << ">(m_buffer, " << GetViewOffsetName(*property) << ");\n";
+        file << "    }\n\n";
+    }
+    for (size_t i = 0; i < variable.size(); ++i) {
+        std::string type = "decltype(" + name + "::" + variable[i]->name + ")";
+        file << "    ReflectionRuntime::ViewValue<" << type << ">::Type " << GetAccessorName(*variable[i]) << "() const noexcept {\n";
+        file << "        return ReflectionRuntime::ReadViewVariable<" << type << ">(m_buffer, kTableOffset, " << i << ");\n";
+        file << "    }\n\n";
+    }
+    
+    file << "    // Write the view format of an object\n";
+    file << "    template <typename Serializer>\n";
+    file << "    static void Write(Serializer& serializer, const " << name << "& object) {\n";
+    file << "        ReflectionRuntime::ViewWriter writer(kTableOffset, kVariableCount);\n";
+    for (const auto* property : fixed) {
+        file << "        writer.AddFixed(" << GetViewOffsetName(*property) << ", object." << property->name << ");\n";
+    }
+    for (size_t i = 0; i < variable.size(); ++i) {
+        file << "        writer.AddVariable(" << i << ", object." << variable[i]->name << ");\n";
+    }
+    file << "        writer.Flush(serializer);\n";
+    file << "    }\n\n";
+    
+    file << "private:\n";
+    file << "    std::span<const std::byte> m_buffer;\n";
+    file << "};\n\n";
+}
+
+void CodeGenerator::WriteSoAClass(std::ofstream& file, const ClassInfo& classInfo) {
+    const std::string& name = classInfo.name;
+    std::vector<const PropertyInfo*> properties = GetIncludedProperties(classInfo);
+    
+    file << "/**\n";
+    file << " * Structure-of-arrays container of " << name << " with one contiguous column per property.\n";
+    file << " * Column indices match " << name << "PropertyIndex.\n";
+    file << " */\n";
+    file << "class " << name << "SoA {\n";
+    file << "public:\n";
+    
+    // Proxies with the property names as members, so soa[i].health reads like player.health
+    for (bool isConst : {false, true}) {
+        file << "    struct " << (isConst ? "ConstReference" : "Reference") << " {\n";
+        for (const auto* property : properties) {
+            file << "        " << (isConst ? "const " : "") << "decltype(" << name << "::" << property->name << ")& "
+                 << property->name << ";\n";
+        }
+        file << "    };\n\n";
+    }
+    
+    file << "    static constexpr ReflectionRuntime::ColumnDescriptor kColumns[] = {\n";
+    for (const auto* property : properties) {
+        file << "        {\"" << property->name << "\", sizeof(decltype(" << name << "::" << property->name
+             << ")), alignof(decltype(" << name << "::" << property->name << "))},\n";
+    }
+    file << "    };\n\n";
+    
+    file << "    size_t Size() const noexcept { return " << (properties.empty() ? "m_size" : "m_" + properties.front()->name + ".Size()") << "; }\n";
+    file << "    bool IsEmpty() const noexcept { return Size() == 0; }\n\n";
+    
+    auto forEachColumn = [&](const std::string& indent, const std::string& call) {
+        for (const auto* property : properties) {
+            file << indent << "m_" << property->name << "." << call << ";\n";
+        }
+    };
+    
+    file << "    void Reserve(size_t capacity) {\n";
+    forEachColumn("        ", "Reserve(capacity)");
+    file << "    }\n\n";
+    
+    file << "    void Clear() {\n";
+    forEachColumn("        ", "Clear()");
+    if (properties.empty()) file << "        m_size = 0;\n";
+    file << "    }\n\n";
+    
+    file << "    void PushBack(const " << name << "& object) {\n";
+    for (const auto* property : properties) {
+        file << "        m_" << property->name << ".PushBack(object." << property->name << ");\n";
+    }
+    if (properties.empty()) file << "        m_size++;\n";
+    file << "    }\n\n";
+    
+    file << "    // Keeps the order of the remaining elements\n";
+    file << "    void Erase(size_t index) {\n";
+    forEachColumn("        ", "Erase(index)");
+    if (properties.empty()) file << "        m_size--;\n";
+    file << "    }\n\n";
+    
+    file << "    // Moves the last element into the erased slot\n";
+    file << "    void SwapErase(size_t index) {\n";
+    forEachColumn("        ", "SwapErase(index)");
+    if (properties.empty()) file << "        m_size--;\n";
+    file << "    }\n\n";
+    
+    for (bool isConst : {false, true}) {
+        file << "    " << (isConst ? "ConstReference" : "Reference") << " operator[](size_t index) "
+             << (isConst ? "const " : "") << "noexcept {\n";
+        file << "        return {";
+        for (size_t i = 0; i < properties.size(); ++i) {
+            file << (i > 0 ? ", " : "") << "m_" << properties[i]->name << "[index]";
+        }
+        file << "};\n";
+        file << "    }\n\n";
+    }
+    
+    file << "    // Copy an element back into an object\n";
+    file << "    void Get(size_t index, " << name << "& object) const {\n";
+    for (const auto* property : properties) {
+        file << "        object." << property->name << " = m_" << property->name << "[index];\n";
+    }
+    file << "    }\n\n";
+    
+    for (const auto* property : properties) {
+        std::string column = GetAccessorName(*property) + "Column";
+        std::string type = "decltype(" + name + "::" + property->name + ")";
+        file << "    std::span<" << type << "> " << column << "() noexcept { return m_" << property->name << ".GetSpan(); }\n";
+        file << "    std::span<const " << type << "> " << column << "() const noexcept { return m_" << property->name << ".GetSpan(); }\n";
+    }
+    if (!properties.empty()) {
+        file << "\n";
+    }
+    
+    file << "    // Type-erased column by property index, for reflection-driven code\n";
+    file << "    ReflectionRuntime::ColumnView GetColumn(size_t propertyIndex) noexcept {\n";
+    file << "        switch (propertyIndex) {\n";
+    for (size_t i = 0; i < properties.size(); ++i) {
+        file << "            case " << i << ": return {m_" << properties[i]->name << ".Data(), Size(), kColumns[" << i << "].elementSize};\n";
+    }
+    file << "            default: return {};\n";
+    file << "        }\n";
+    file << "    }\n\n";
+    
+    file << "private:\n";
+    for (const auto* property : properties) {
+        file << "    ReflectionRuntime::Column<decltype(" << name << "::" << property->name << ")> m_" << property->name << ";\n";
+    }
+    if (properties.empty()) {
+        file << "    size_t m_size = 0;\n";
+    }
+    file << "};\n\n";
+}
+
+void CodeGenerator::WriteSerializedSize(std::ofstream& file, const ClassInfo& classInfo) {
+    const std::string& name = classInfo.name;
+    const std::string& base = classInfo.baseClass;
+    std::vector<const PropertyInfo*> properties = GetSerializedProperties(classInfo);
+    std::string header = "ReflectionRuntime::GetSchemaHeaderSize(" + std::to_string(properties.size()) + ", " +
+                         (classInfo.tagged ? "true" : "false") + ")";
+    std::string fixedSize = "GetFixedSerializedSize(static_cast<const " + name + "*>(nullptr))";
+    
+    file << "// Bytes " << name << "::Serialize writes for every object, ReflectionRuntime::kVariableSize\n";
+    file << "// if the size depends on the values\n";
+    file << "constexpr size_t GetFixedSerializedSize(const " << name << "*) noexcept {\n";
+    file << "    return ReflectionRuntime::AddFixedSizes(\n";
+    if (!base.empty()) {
+        file << "        " << GetBaseCall(classInfo, "size_t(0)", "const auto* base", "GetFixedSerializedSize(base)")
+             << ",\n";
+    }
+    file << "        " << header;
+    for (const auto* property : properties) {
+        file << ",\n        ReflectionRuntime::kFixedSerializedSize<decltype(" << name << "::" << property->name << ")>";
+    }
+    file << ");\n";
+    file << "}\n\n";
+    
+    // Whether the size is fixed depends on the base and on member types, so the compiler decides
+    file << "// Converts to the size when it is fixed, see ReflectionRuntime::FixedSerializedSize\n";
+    file << "inline constexpr ReflectionRuntime::FixedSerializedSize<" << fixedSize << "> k" << name
+         << "SerializedSize{};\n\n";
+    
+    file << "// Bytes " << name << "::Serialize writes for this object, to reserve serializer buffers once\n";
+    file << "inline size_t SerializedSize(const " << name << "& object) {\n";
+    file << "    if constexpr (" << fixedSize << " != ReflectionRuntime::kVariableSize) {\n";
+    file << "        return " << fixedSize << ";\n";
+    file << "    } else {\n";
+    file << "        return ";
+    if (!base.empty()) {
+        file << GetBaseCall(classInfo, "size_t(0)", "const auto& base", "SerializedSize(base)", "object")
+             << " +\n               ";
+    }
+    file << header;
+    for (const auto* property : properties) {
+        file << " +\n               ReflectionRuntime::GetSerializedSize(object." << property->name << ")";
+    }
+    file << ";\n";
+    file << "    }\n";
+    file << "}\n\n";
+}
+
+void CodeGenerator::WriteHashFunctions(std::ofstream& file, const ClassInfo& classInfo) {
+    const std::string& name = classInfo.name;
+    const std::string& base = classInfo.baseClass;
+    std::vector<std::vector<const PropertyInfo*>> runs = GetSerializationRuns(classInfo);
+    
+    // Runs whose bytes are their serialized form are hashed and compared straight from memory
+    file << "// Content hash of the Save properties of " << name << ", stable across builds and platforms,\n";
+    file << "// see ReflectionRuntime::Hasher\n";
+    file << "inline void HashProperties(ReflectionRuntime::Hasher& hasher, const " << name << "& object) {\n";
+    if (!base.empty()) {
+        file << "    " << GetBaseCall(classInfo, "nullptr", "const auto& base", "HashProperties(hasher, base)", "object")
+             << ";\n";
+    }
+    for (const auto& run : runs) {
+        if (run.size() == 1) {
+            file << "    ReflectionRuntime::AppendHash(hasher, object." << run.front()->name << ");\n";
+            continue;
+        }
+        
+        file << "    if constexpr (" << GetRunCondition(classInfo, run, 0, "IsBitwiseComparable") << ") {\n";
+        file << "        hasher.WriteBytes(reinterpret_cast<const char*>(&object) + offsetof(" << name << ", "
+             << run.front()->name << "), " << GetRunSize(classInfo, run) << ");\n";
+        file << "    } else {\n";
+        for (const auto* property : run) {
+            file << "        ReflectionRuntime::AppendHash(hasher, object." << property->name << ");\n";
+        }
+        file << "    }\n";
+    }
+    file << "}\n\n";
+    
+    file << "inline uint64_t Hash(const " << name << "& object) {\n";
+    file << "    ReflectionRuntime::Hasher hasher;\n";
+    file << "    HashProperties(hasher, object);\n";
+    file << "    return hasher.Finish();\n";
+    file << "}\n\n";
+    
+    file << "// Whether two objects have the same Save properties, consistent with Hash\n";
+    file << "inline bool Equals(const " << name << "& a, const " << name << "& b) {\n";
+    if (!base.empty()) {
+        file << "    if (!" << GetBaseCall(classInfo, "true", "const auto& a, const auto& b", "Equals(a, b)", "a, b") << ") {\n";
+        file << "        return false;\n";
+        file << "    }\n";
+    }
+    for (const auto& run : runs) {
+        if (run.size() == 1) {
+            file << "    if (!ReflectionRuntime::EqualValues(a." << run.front()->name << ", b." << run.front()->name << ")) {\n";
+            file << "        return false;\n";
+            file << "    }\n";
+            continue;
+        }
+        
+        std::string offset = "offsetof(" + name + ", " + run.front()->name + ")";
+        file << "    if constexpr (" << GetRunCondition(classInfo, run, 0, "IsBitwiseComparable") << ") {\n";
+        file << "        if (std::memcmp(reinterpret_cast<const char*>(&a) + " << offset << ",\n";
+        file << "                        reinterpret_cast<const char*>(&b) + " << offset << ",\n";
+        file << "                        " << GetRunSize(classInfo, run) << ") != 0) {\n";
+        file << "            return false;\n";
+        file << "        }\n";
+        file << "    } else {\n";
+        for (size_t i = 0; i < run.size(); ++i) {
+            file << (i == 0 ? "        if (!" : "            !") << "ReflectionRuntime::EqualValues(a." << run[i]->name
+                 << ", b." << run[i]->name << ")" << (i + 1 < run.size() ? " ||\n" : ") {\n");
+        }
+        file << "            return false;\n";
+        file << "        }\n";
+        file << "    }\n";
+    }
+    file << "    return true;\n";
+    file << "}\n\n";
+}
+
+void CodeGenerator::WriteJsonFunctions(std::ofstream& file, const ClassInfo& classInfo) {
+    const std::string& name = classInfo.name;
+    const std::string& base = classInfo.baseClass;
+    std::vector<const PropertyInfo*> properties = GetSerializedProperties(classInfo);
+    
+    file << "// Streaming JSON of the Save properties of " << name << ", base class members first\n";
+    file << "inline void WriteJsonProperties(ReflectionRuntime::JsonWriter& writer, const " << name << "& object) {\n";
+    if (!base.empty()) {
+        file << "    " << GetBaseCall(classInfo, "nullptr", "const auto& base", "WriteJsonProperties(writer, base)", "object")
+             << ";\n";
+    }
+    for (const auto* property : properties) {
+        file << "    writer.Key(R\"(\"" << property->name << "\":)\");\n";
+        file << "    ReflectionRuntime::WriteJsonValue(writer, object." << property->name << ");\n";
+    }
+    file << "}\n\n";
+    
+    file << "inline void WriteJson(ReflectionRuntime::JsonWriter& writer, const " << name << "& object) {\n";
+    file << "    writer.BeginObject();\n";
+    file << "    WriteJsonProperties(writer, object);\n";
+    file << "    writer.EndObject();\n";
+    file << "}\n\n";
+    
+    // Keys go through the perfect hash of the property names, which indexes all
+    // included properties, so the switch only lists the Save ones
+    file << "// Read the value of one member into its property, false if " << name << " has no Save\n";
+    file << "// property with that name\n";
+    file << "inline bool ReadJsonProperty(ReflectionRuntime::JsonReader& reader, std::string_view key, "
+         << name << "& object) {\n";
+    file << "    switch (Find" << name << "PropertyIndex(key)) {\n";
+    for (const auto* property : properties) {
+        file << "        case " << name << "PropertyIndex::" << property->name << ":\n";
+        file << "            ReflectionRuntime::ReadJsonValue(reader, object." << property->name << ");\n";
+        file << "            return true;\n";
+    }
+    file << "        default:\n";
+    if (!base.empty()) {
+        file << "            return " << GetBaseCall(classInfo, "false", "auto& base", "ReadJsonProperty(reader, key, base)", "object")
+             << ";\n";
+    } else {
+        file << "            return false;\n";
+    }
+    file << "    }\n";
+    file << "}\n\n";
+    
+    file << "// Members the class does not know are skipped, missing ones keep their value\n";
+    file << "inline bool ReadJson(ReflectionRuntime::JsonReader& reader, " << name << "& object) {\n";
+    file << "    if (!reader.BeginObject()) {\n";
+    file << "        return false;\n";
+    file << "    }\n";
+    file << "    std::string_view key;\n";
+    file << "    while (reader.NextKey(key)) {\n";
+    file << "        if (!ReadJsonProperty(reader, key, object)) {\n";
+    file << "            reader.SkipValue();\n";
+    file << "        }\n";
+    file << "    }\n";
+    file << "    return reader.IsValid();\n";
+    file << "}\n\n";
+}
+
+void CodeGenerator::WritePatchFunctions(std::ofstream& file, const ClassInfo& classInfo) {
+    const std::string& name = classInfo.name;
+    const std::string& base = classInfo.baseClass;
+    std::string baseCount = base.empty() ? "0" : GetBaseCall(classInfo, "0", "const auto* base", "GetPatchIndexCount(base)");
+    
+    // Values of properties of this class type in other classes' patches
+    file << "// Every Save property of " << name << ", as a patch value, base class members first\n";
+    file << "inline void WritePatchProperties(ReflectionRuntime::PropertyPatch& patch, const " << name << "& object) {\n";
+    if (!base.empty()) {
+        file << "    " << GetBaseCall(classInfo, "nullptr", "const auto& base", "WritePatchProperties(patch, base)", "object")
+             << ";\n";
+    }
+    for (const auto* property : GetSerializedProperties(classInfo)) {
+        file << "    ReflectionRuntime::AppendPatchValue(patch, object." << property->name << ");\n";
+    }
+    file << "}\n\n";
+    
+    file << "inline void ReadPatchProperties(ReflectionRuntime::PatchReader& reader, " << name << "& object) {\n";
+    if (!base.empty()) {
+        file << "    " << GetBaseCall(classInfo, "nullptr", "auto& base", "ReadPatchProperties(reader, base)", "object")
+             << ";\n";
+    }
+    for (const auto* property : GetSerializedProperties(classInfo)) {
+        file << "    ReflectionRuntime::ReadPatchValue(reader, object." << property->name << ");\n";
+    }
+    file << "}\n\n";
+    
+    file << "// Patch indices of " << name << ", its own properties follow those of the base classes\n";
+    file << "constexpr uint16_t GetPatchIndexCount(const " << name << "*) noexcept {\n";
+    file << "    return " << baseCount << " + k" << name << "PropertyCount;\n";
+    file << "}\n\n";
+    
+    auto writeChange = [&](const PropertyInfo& property, const std::string& indent) {
+        file << indent << "if (!ReflectionRuntime::EqualValues(a." << property.name << ", b." << property.name << ")) {\n";
+        file << indent << "    patch.Add(kBaseCount + " << name << "PropertyIndex::" << property.name << ", b."
+             << property.name << ");\n";
+        file << indent << "}\n";
+    };
+    
+    // An unchanged run costs one memcmp, only a changed one is compared property by property
+    file << "// Append the Save properties that differ between a and b, with their values in b\n";
+    file << "inline void DiffProperties(ReflectionRuntime::PropertyPatch& patch, const " << name << "& a, const "
+         << name << "& b) {\n";
+    file << "    constexpr uint16_t kBaseCount = " << baseCount << ";\n";
+    if (!base.empty()) {
+        file << "    " << GetBaseCall(classInfo, "nullptr", "const auto& a, const auto& b", "DiffProperties(patch, a, b)", "a, b")
+             << ";\n";
+    }
+    for (const auto& run : GetSerializationRuns(classInfo)) {
+        if (run.size() == 1) {
+            writeChange(*run.front(), "    ");
+            continue;
+        }
+        
+        std::string offset = "offsetof(" + name + ", " + run.front()->name + ")";
+        file << "    if constexpr (" << GetRunCondition(classInfo, run, 0, "IsBitwiseComparable") << ") {\n";
+        file << "        if (std::memcmp(reinterpret_cast<const char*>(&a) + " << offset << ",\n";
+        file << "                        reinterpret_cast<const char*>(&b) + " << offset << ",\n";
+        file << "                        " << GetRunSize(classInfo, run) << ") != 0) {\n";
+        for (const auto* property : run) {
+            writeChange(*property, "            ");
+        }
+        file << "        }\n";
+        file << "    } else {\n";
+        for (const auto* property : run) {
+            writeChange(*property, "        ");
+        }
+        file << "    }\n";
+    }
+    file << "}\n\n";
+    
+    file << "// Changes that turn a into b\n";
+    file << "inline ReflectionRuntime::PropertyPatch Diff(const " << name << "& a, const " << name << "& b) {\n";
+    file << "    ReflectionRuntime::PropertyPatch patch;\n";
+    file << "    DiffProperties(patch, a, b);\n";
+    file << "    return patch;\n";
+    file << "}\n\n";
+    
+    file << "// Read the value of one patch entry into its property, false for an unknown index\n";
+    file << "inline bool ApplyPatchProperty(ReflectionRuntime::PatchReader& reader, uint16_t index, " << name
+         << "& object) {\n";
+    file << "    constexpr uint16_t kBaseCount = " << baseCount << ";\n";
+    if (!base.empty()) {
+        file << "    if (index < kBaseCount) {\n";
+        file << "        return " << GetBaseCall(classInfo, "false", "auto& base", "ApplyPatchProperty(reader, index, base)", "object")
+             << ";\n";
+        file << "    }\n";
+    }
+    file << "    switch (index - kBaseCount) {\n";
+    for (const auto* property : GetSerializedProperties(classInfo)) {
+        file << "        case " << name << "PropertyIndex::" << property->name << ":\n";
+        file << "            ReflectionRuntime::ReadPatchValue(reader, object." << property->name << ");\n";
+        file << "            return true;\n";
+    }
+    file << "        default:\n";
+    file << "            return false;\n";
+    file << "    }\n";
+    file << "}\n\n";
+    
+    file << "// Values after an unknown index cannot be located, so such a patch is rejected there\n";
+    file << "inline bool ApplyPatch(" << name << "& object, const ReflectionRuntime::PropertyPatch& patch) {\n";
+    file << "    ReflectionRuntime::PatchReader reader(patch);\n";
+    file << "    uint16_t index = 0;\n";
+    file << "    while (reader.Next(index)) {\n";
+    file << "        if (!ApplyPatchProperty(reader, index, object)) {\n";
+    file << "            return false;\n";
+    file << "        }\n";
+    file << "    }\n";
+    file << "    return reader.IsValid();\n";
+    file << "}\n\n";
+}
+
+void CodeGenerator::WriteBatchFunctions(std::ofstream& file, const ClassInfo& classInfo) {
+    const std::string& name = classInfo.name;
+    std::vector<const PropertyInfo*> properties = GetSerializedProperties(classInfo);
+    
+    file << "/**\n";
+    file << " * Columnar serialization of many " << name << " objects: the element count, the base class\n";
+    file << " * data of every element, then each Save property as one contiguous column\n";
+    file << " */\n";
+    file << "template <typename Serializer>\n";
+    file << "void SerializeBatch(Serializer& serializer, std::span<const " << name << "> objects) {\n";
+    file << "    ReflectionRuntime::WriteLength(serializer, objects.size());\n";
+    if (!classInfo.baseClass.empty()) {
+        file << "    for (const auto& object : objects) {\n";
+        file << "        object." << classInfo.baseClass << "::Serialize(serializer);\n";
+        file << "    }\n";
+    }
+    for (const auto* property : properties) {
+        file << "    ReflectionRuntime::WriteColumn(serializer, objects, &" << name << "::" << property->name << ");\n";
+    }
+    file << "}\n\n";
+    
+    file << "// Read a batch into existing objects, false if it holds a different number of them\n";
+    file << "template <typename Deserializer>\n";
+    file << "bool DeserializeBatch(Deserializer& deserializer, std::span<" << name << "> objects) {\n";
+    file << "    if (ReflectionRuntime::ReadLength(deserializer) != objects.size()) {\n";
+    file << "        return false;\n";
+    file << "    }\n";
+    if (!classInfo.baseClass.empty()) {
+        file << "    for (auto& object : objects) {\n";
+        file << "        object." << classInfo.baseClass << "::Deserialize(deserializer);\n";
+        file << "    }\n";
+    }
+    for (const auto* property : properties) {
+        file << "    ReflectionRuntime::ReadColumn(deserializer, objects, &" << name << "::" << property->name << ");\n";
+    }
+    file << "    return true;\n";
+    file << "}\n\n";
+    
+    file << "// Read a batch of any size, resizing the vector to it\n";
+    file << "template <typename Deserializer>\n";
+    file << "void DeserializeBatch(Deserializer& deserializer, std::vector<" << name << ">& objects) {\n";
+    file << "    objects.resize(ReflectionRuntime::ReadLength(deserializer));\n";
+    file << "    std::span<" << name << "> elements(objects);\n";
+    if (!classInfo.baseClass.empty()) {
+        file << "    for (auto& object : elements) {\n";
+        file << "        object." << classInfo.baseClass << "::Deserialize(deserializer);\n";
+        file << "    }\n";
+    }
+    for (const auto* property : properties) {
+        file << "    ReflectionRuntime::ReadColumn(deserializer, elements, &" << name << "::" << property->name << ");\n";
+    }
+    file << "}\n\n";
+}
+
+void CodeGenerator::WriteCompactFunctions(std::ofstream& file, const ClassInfo& classInfo) {
+    const std::string& name = classInfo.name;
+    std::vector<const PropertyInfo*> properties = GetSerializedProperties(classInfo);
+    
+    file << "// Compact bit-packed encoding of the Save properties of " << name << ", base class members first\n";
+    file << "inline void SerializeCompact(ReflectionRuntime::BitWriter& writer, const " << name << "& object) {\n";
+    if (!classInfo.baseClass.empty()) {
+        file << "    " << GetBaseCall(classInfo, "nullptr", "const auto& base", "SerializeCompact(writer, base)", "object")
+             << ";\n";
+    }
+    for (const auto* property : properties) {
+        file << "    ReflectionRuntime::Write" << GetCompactEncoding(*property) << "(writer, object." << property->name << ");\n";
+    }
+    file << "}\n\n";
+    
+    file << "inline void DeserializeCompact(ReflectionRuntime::BitReader& reader, " << name << "& object) {\n";
+    if (!classInfo.baseClass.empty()) {
+        file << "    " << GetBaseCall(classInfo, "nullptr", "auto& base", "DeserializeCompact(reader, base)", "object")
+             << ";\n";
+    }
+    for (const auto* property : properties) {
+        file << "    ReflectionRuntime::Read" << GetCompactEncoding(*property) << "(reader, object." << property->name << ");\n";
+    }
+    file << "}\n\n";
+}
+
+std::string CodeGenerator::GetCompactEncoding(const PropertyInfo& property) {
+    // Clamped integers and enums take the minimum number of bits for their range,
+    // clamped floats with a Quantize(N) take N bits
+    if (property.clampMin.empty() || property.clampMax.empty()) {
+        return "Compact";
+    }
+    std::string range = "(" + property.clampMin + "), (" + property.clampMax + ")";
+    if (property.kind == PropertyKind::Integer || property.kind == PropertyKind::Enum) {
+        return "Clamped<" + range + ">";
+    }
+    if (property.kind == PropertyKind::Float && property.quantizeBits > 0) {
+        return "Quantized<" + range + ", " + std::to_string(property.quantizeBits) + ">";
+    }
+    return "Compact";
+}
+
+void CodeGenerator::WriteDeltaFunctions(std::ofstream& file, const ClassInfo& classInfo) {
+    const std::string& name = classInfo.name;
+    const std::string bits = "object." + classInfo.dirtyBitsMember;
+    std::vector<const PropertyInfo*> properties = GetSerializedProperties(classInfo);
+    
+    // Bits follow the order of the Save properties
+    file << "// Dirty bit of each Save property of " << name << "\n";
+    file << "namespace " << name << "DirtyBit {\n";
+    file << "    enum : uint16_t {\n";
+    for (size_t i = 0; i < properties.size(); ++i) {
+        file << "        " << properties[i]->name << " = " << i << ",\n";
+    }
+    file << "    };\n";
+    file << "}\n";
+    file << "inline constexpr uint16_t k" << name << "DirtyBitCount = " << properties.size() << ";\n\n";
+    file << "static_assert(decltype(" << name << "::" << classInfo.dirtyBitsMember << ")::kSize >= k" << name
+         << "DirtyBitCount,\n";
+    file << "              \"" << name << "::" << classInfo.dirtyBitsMember << " needs a bit for every Save property\");\n\n";
+    file << "// Lets derived classes check that their base class tracks its Save properties too\n";
+    file << "constexpr uint16_t GetDirtyBitCount(const " << name << "*) noexcept {\n";
+    file << "    return k" << name << "DirtyBitCount;\n";
+    file << "}\n\n";
+    
+    // Setters mark a property only when its value changes, mark hooks are for in-place edits
+    for (size_t i = 0; i < properties.size(); ++i) {
+        const std::string& property = properties[i]->name;
+        std::string type = "decltype(" + name + "::" + property + ")";
+        file << "inline void " << GetAccessorName(*properties[i], "Set") << "(" << name
+             << "& object, const " << type << "& value) {\n";
+        file << "    if (ReflectionRuntime::IsUnchanged(object." << property << ", value)) {\n";
+        file << "        return;\n";
+        file << "    }\n";
+        file << "    object." << property << " = value;\n";
+        file << "    " << bits << ".Set(" << name << "DirtyBit::" << property << ");\n";
+        file << "}\n\n";
+        file << "inline void " << GetAccessorName(*properties[i], "Mark") << "Dirty(" << name << "& object) {\n";
+        file << "    " << bits << ".Set(" << name << "DirtyBit::" << property << ");\n";
+        file << "}\n\n";
+    }
+    
+    file << "/**\n";
+    file << " * Write the dirty bits and the dirty Save properties of an object, after the delta of its\n";
+    file << " * base class. The bits are left set, clear them once every receiver has been sent the delta.\n";
+    file << " */\n";
+    file << "template <typename Serializer>\n";
+    file << "void SerializeDelta(Serializer& serializer, const " << name << "& object) {\n";
+    if (!classInfo.baseClass.empty()) {
+        // The base class part is written with the base's own dirty bits, so a base with
+        // Save properties has to track them
+        std::string baseReplicated = GetBaseCall(classInfo, "false", "const auto* base", "GetDirtyBitCount(base) > 0");
+        file << "    static_assert(" << baseReplicated << " ||\n";
+        file << "                  !ReflectionRuntime::CallBase<" << classInfo.baseClass
+             << ">(false, [](const auto* base) -> decltype(WritePatchProperties(std::declval<ReflectionRuntime::PropertyPatch&>(), *base), true) { return true; }),\n";
+        file << "                  \"The Save properties of " << classInfo.baseClass << " are only part of the deltas of "
+             << name << " if it is GCLASS(Replicated) as well\");\n";
+        file << "    " << GetBaseCall(classInfo, "nullptr", "const auto& base", "SerializeDelta(serializer, base)", "object")
+             << ";\n";
+    }
+    file << "    " << bits << ".Write(serializer, k" << name << "DirtyBitCount);\n";
+    file << "    " << bits << ".ForEachSet([&](size_t bit) {\n";
+    file << "        switch (bit) {\n";
+    for (size_t i = 0; i < properties.size(); ++i) {
+        file << "        case " << i << ": ReflectionRuntime::Write(serializer, object." << properties[i]->name
+             << "); break;\n";
+    }
+    file << "        }\n";
+    file << "    });\n";
+    file << "}\n\n";
+    
+    file << "// Apply a delta written by SerializeDelta, the object's own dirty bits are not touched\n";
+    file << "template <typename Deserializer>\n";
+    file << "void ApplyDelta(Deserializer& deserializer, " << name << "& object) {\n";
+    if (!classInfo.baseClass.empty()) {
+        file << "    " << GetBaseCall(classInfo, "nullptr", "auto& base", "ApplyDelta(deserializer, base)", "object")
+             << ";\n";
+    }
+    file << "    decltype(" << bits << ") changed;\n";
+    file << "    changed.Read(deserializer, k" << name << "DirtyBitCount);\n";
+    file << "    changed.ForEachSet([&](size_t bit) {\n";
+    file << "        switch (bit) {\n";
+    for (size_t i = 0; i < properties.size(); ++i) {
+        file << "        case " << i << ": ReflectionRuntime::Read(deserializer, object." << properties[i]->name
+             << "); break;\n";
+    }
+    file << "        }\n";
+    file << "    });\n";
+    file << "}\n\n";
+}
+
+std::vector<const PropertyInfo*> CodeGenerator::GetViewProperties(const ClassInfo& classInfo) {
+    std::vector<const PropertyInfo*> properties;
+    if (!classInfo.serializable) {
+        return properties;
+    }
+    for (const auto& property : classInfo.properties) {
+        if (IsPropertySerialized(property) &&
+            (IsFixedViewProperty(property) || property.kind == PropertyKind::String || property.kind == PropertyKind::Vector)) {
+            properties.push_back(&property);
+        }
+    }
+    return properties;
+}
+
+bool CodeGenerator::IsFixedViewProperty(const PropertyInfo& property) {
+    return property.bulkCopyable || property.kind == PropertyKind::Bool;
+}
+
+std::string CodeGenerator::GetViewOffsetName(const PropertyInfo& property) {
+    std::string name = property.name;
+    if (!name.empty()) {
+        name[0] = static_cast<char>(std::toupper(static_cast<unsigned char>(name[0])));
+    }
+    return "k" + name + "Offset";
+}
+
+std::string CodeGenerator::GetAccessorName(const PropertyInfo& property, const std::string& prefix) {
+    std::string name = property.name;
+    if (!name.empty()) {
+        name[0] = static_cast<char>(std::toupper(static_cast<unsigned char>(name[0])));
+    }
+    return prefix + name;
+}
+
+std::string CodeGenerator::GetPropertyFlagsString(const PropertyInfo& property) {
     std::stringstream flags;
     flags << "GProperty::Flags::";
     
@@ -363,6 +1973,36 @@ std::string CodeGenerator::GetFunctionFlagsString(const FunctionInfo& function)
     return flags.str();
 }
 
+std::string CodeGenerator::GetDescriptorFlagsString(const PropertyInfo& property) {
+    std::vector<std::string> names;
+    if (property.save) names.push_back("Save");
+    if (property.edit) names.push_back("Edit");
+    if (property.transient) names.push_back("Transient");
+    if (property.editorOnly) names.push_back("EditorOnly");
+    if (property.readOnly) names.push_back("ReadOnly");
+    if (names.empty()) names.push_back("None");
+    
+    std::stringstream flags;
+    for (size_t i = 0; i < names.size(); ++i) {
+        flags << (i > 0 ? " | " : "") << "ReflectionRuntime::PropertyFlags::" << names[i];
+    }
+    return flags.str();
+}
+
+std::string CodeGenerator::GetDescriptorFlagsString(const FunctionInfo& function) {
+    std::vector<std::string> names;
+    if (function.callable) names.push_back("Callable");
+    if (function.blueprintEvent) names.push_back("BlueprintEvent");
+    if (function.blueprintCallable) names.push_back("BlueprintCallable");
+    if (names.empty()) names.push_back("None");
+    
+    std::stringstream flags;
+    for (size_t i = 0; i < names.size(); ++i) {
+        flags << (i > 0 ? " | " : "") << "ReflectionRuntime::FunctionFlags::" << names[i];
+    }
+    return flags.str();
+}
+
 std::string CodeGenerator::GetClassFlagsString(const ClassInfo& classInfo) {
     std::stringstream flags;
     
@@ -412,6 +2052,57 @@ std::string CodeGenerator::GetPropertyTypeName(const std::string& typeName) {
     return typeName;
 }
 
+bool CodeGenerator::HasExtensionHeader(const ClassInfo& classInfo) {
+    return !GetIncludedProperties(classInfo).empty() || classInfo.soa || HasBatchFunctions(classInfo) ||
+           HasCompactFunctions(classInfo) || HasDeltaFunctions(classInfo);
+}
+
+bool CodeGenerator::HasBatchFunctions(const ClassInfo& classInfo) {
+    return classInfo.serializable && HasSerializedProperties(classInfo);
+}
+
+bool CodeGenerator::HasCompactFunctions(const ClassInfo& classInfo) {
+    return classInfo.serializable && HasSerializedProperties(classInfo);
+}
+
+bool CodeGenerator::HasDeltaFunctions(const ClassInfo& classInfo) {
+    return classInfo.replicated && !classInfo.dirtyBitsMember.empty() && HasSerializedProperties(classInfo);
+}
+
+std::vector<const PropertyInfo*> CodeGenerator::GetSerializedProperties(const ClassInfo& classInfo) {
+    std::vector<const PropertyInfo*> properties;
+    for (const auto& property : classInfo.properties) {
+        if (IsPropertySerialized(property)) {
+            properties.push_back(&property);
+        }
+    }
+    return properties;
+}
+
+bool CodeGenerator::HasSerializedProperties(const ClassInfo& classInfo) {
+    for (const auto& property : classInfo.properties) {
+        if (IsPropertySerialized(property)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+bool CodeGenerator::IsPropertyIncluded(const PropertyInfo& property) {
+    // Bit-fields cannot be bound to a reference, pointed to or located with offsetof,
+    // which registration, serialization and the property list all do
+    if (property.bitField) {
+        return false;
+    }
+    
+    // Runtime builds have no use for editor-only data
+    return !(m_options.flavor == GenerationFlavor::Runtime && property.editorOnly);
+}
+
+bool CodeGenerator::IsPropertySerialized(const PropertyInfo& property) {
+    return property.save && !property.transient && IsPropertyIncluded(property);
+}
+
 void CodeGenerator::EnsureDirectoryExists(const std::string& path) {
     if (!path.empty()) {
         std::filesystem::create_directories(path);
@@ -422,7 +2113,7 @@ std::string CodeGenerator::GetRelativePath(const std::string& from, const std::s
     std::filesystem::path fromPath(from);
     std::filesystem::path toPath(to);
     
-    return std::filesystem::relative(toPath, fromPath.parent_path()).string();
+    return std::filesystem::relative(toPath, fromPath.parent_path()).generic_string();
 }
 
 } // namespace ReflectionGenerator
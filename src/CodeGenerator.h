@@ -7,18 +7,51 @@
 
 namespace ReflectionGenerator {
 
+/**
+ * Build flavor the generated code is emitted for
+ */
+enum class GenerationFlavor {
+    Default,    // Every property, no editor metadata
+    Editor,     // Every property plus category and tooltip metadata
+    Runtime     // EditorOnly properties and editor metadata stripped
+};
+
+/**
+ * Options that control the shape of the generated code
+ */
+struct GeneratorOptions {
+    // Emit only the includes each generated file needs instead of the full engine headers
+    bool leanIncludes = false;
+
+    // Flavor of the emitted registration and serialization code
+    GenerationFlavor flavor = GenerationFlavor::Default;
+
+    // Describe types with constexpr descriptor tables in read-only data instead of
+    // building GType, GProperty and GFunction objects on the heap at startup
+    bool staticDescriptors = false;
+
+    // Register types from a sorted per-module table on first lookup instead of one
+    // static initializer per class
+    bool lazyRegistration = false;
+
+    // Name of the module in module-wide generated symbols such as Register<Module>ReflectionTypes,
+    // so several modules can be linked into one binary. Empty uses the output directory name.
+    std::string moduleName;
+};
+
 /**
  * Generates reflection code from parsed class information
  */
 class CodeGenerator {
 public:
-    explicit CodeGenerator(const std::string& outputDir);
+    explicit CodeGenerator(const std::string& outputDir, const GeneratorOptions& options = {});
     ~CodeGenerator() = default;
 
     /**
      * Generate reflection code for a file
      * @param filePath Path to the source file
      * @param classes Vector of ClassInfo objects to generate code for
+     * @throws std::runtime_error if an output file cannot be written
      */
     void GenerateCode(const std::string& filePath, const std::vector<ClassInfo>& classes);
 
@@ -36,6 +69,13 @@ public:
      */
     void GenerateImplementation(const ClassInfo& classInfo, const std::string& outputPath);
 
+    /**
+     * Generate the header-only code that needs the complete class, such as views
+     * @param classInfo Class information
+     * @param outputPath Output file path
+     */
+    void GenerateExtensionHeader(const ClassInfo& classInfo, const std::string& outputPath);
+
     /**
      * Generate registration code for all classes
      * @param classes Vector of all ClassInfo objects
@@ -43,8 +83,33 @@ public:
      */
     void GenerateRegistration(const std::vector<ClassInfo>& classes, const std::string& outputPath);
 
+    /**
+     * Generate one registration function for every class of the module
+     * @param classes Summaries of all classes generated into this output directory
+     */
+    void GenerateModuleRegistration(const std::vector<ClassSummary>& classes);
+
+    /**
+     * Get the name of a flavor as used on the command line and for output subdirectories
+     */
+    static std::string GetFlavorName(GenerationFlavor flavor);
+
+    /**
+     * Parse a flavor name ("editor", "runtime")
+     * @return True if the name is a known flavor
+     */
+    static bool ParseFlavorName(const std::string& name, GenerationFlavor& flavor);
+
+    /**
+     * Get the module name used when none is configured: the last component of the
+     * output directory, made a valid identifier
+     */
+    static std::string GetDefaultModuleName(const std::string& outputDir);
+
 private:
     std::string m_outputDir;
+    GeneratorOptions m_options;
+    std::string m_moduleName;
     
     // Helper methods
     std::string GetOutputPath(const std::string& filePath, const std::string& suffix);
@@ -57,19 +122,87 @@ private:
     void WriteHeaderIncludes(std::ofstream& file, const ClassInfo& classInfo);
     void WriteHeaderClass(std::ofstream& file, const ClassInfo& classInfo);
     void WriteHeaderEpilogue(std::ofstream& file, const ClassInfo& classInfo);
+    void WriteHeaderFactory(std::ofstream& file, const ClassInfo& classInfo);
+    std::string GetPoolArguments(const ClassInfo& classInfo);
+    void WriteHeaderMemberIndices(std::ofstream& file, const ClassInfo& classInfo);
     
     void WriteImplementationPreamble(std::ofstream& file, const ClassInfo& classInfo);
     void WriteImplementationIncludes(std::ofstream& file, const ClassInfo& classInfo);
     void WriteImplementationClass(std::ofstream& file, const ClassInfo& classInfo);
+    void WriteRegistrationFunction(std::ofstream& file, const ClassInfo& classInfo);
     void WriteImplementationEpilogue(std::ofstream& file, const ClassInfo& classInfo);
     
     // Property and function generation
     void WritePropertyRegistration(std::ofstream& file, const PropertyInfo& property);
-    void WriteFunctionRegistration(std::ofstream& file, const FunctionInfo& function);
+    void WriteFunctionRegistration(std::ofstream& file, const ClassInfo& classInfo, const FunctionInfo& function,
+                                   size_t index);
+    std::string GetInvokeThunk(const ClassInfo& classInfo, const FunctionInfo& function);
+    void WriteMetadata(std::ofstream& file, const std::string& variable,
+                       const std::string& category, const std::string& tooltip);
+    
+    // Module registration generation
+    void WriteModuleTypeTable(std::ofstream& file, const std::vector<ClassSummary>& classes);
+    void GenerateTypeHierarchy(const std::vector<ClassSummary>& classes);
+    size_t FindBaseClass(const std::vector<const ClassSummary*>& classes, const ClassSummary& classInfo);
+    
+    // Member name lookup generation
+    void WriteFactoryFunctions(std::ofstream& file, const ClassInfo& classInfo);
+    void WriteNameIndices(std::ofstream& file, const ClassInfo& classInfo);
+    void WriteNameIndex(std::ofstream& file, const std::string& prefix, const std::vector<std::string>& names);
+    std::vector<const PropertyInfo*> GetIncludedProperties(const ClassInfo& classInfo);
+    std::vector<std::string> GetMemberNames(const std::vector<const PropertyInfo*>& properties);
+    std::vector<std::string> GetMemberNames(const std::vector<FunctionInfo>& functions);
+    
+    // Static descriptor generation
+    void WriteStaticDescriptors(std::ofstream& file, const ClassInfo& classInfo);
+    std::string GetDescriptorFlagsString(const PropertyInfo& property);
+    std::string GetDescriptorFlagsString(const FunctionInfo& function);
+    
+    // Structure-of-arrays generation
+    void WriteSoAClass(std::ofstream& file, const ClassInfo& classInfo);
+    
+    // Serialized size generation
+    void WriteSerializedSize(std::ofstream& file, const ClassInfo& classInfo);
+    
+    // Content hash and equality generation
+    void WriteHashFunctions(std::ofstream& file, const ClassInfo& classInfo);
+    
+    // JSON generation
+    void WriteJsonFunctions(std::ofstream& file, const ClassInfo& classInfo);
+    
+    // Diff and patch generation
+    void WritePatchFunctions(std::ofstream& file, const ClassInfo& classInfo);
+    
+    // Batch serialization generation
+    void WriteBatchFunctions(std::ofstream& file, const ClassInfo& classInfo);
+    
+    // Compact serialization generation
+    void WriteCompactFunctions(std::ofstream& file, const ClassInfo& classInfo);
+    std::string GetCompactEncoding(const PropertyInfo& property);
+    
+    // Delta serialization generation
+    void WriteDeltaFunctions(std::ofstream& file, const ClassInfo& classInfo);
+    
+    // Compile-time property list generation
+    void WritePropertyFields(std::ofstream& file, const ClassInfo& classInfo);
+    
+    // View generation
+    void WriteViewClass(std::ofstream& file, const ClassInfo& classInfo);
+    std::vector<const PropertyInfo*> GetViewProperties(const ClassInfo& classInfo);
+    bool IsFixedViewProperty(const PropertyInfo& property);
+    std::string GetViewOffsetName(const PropertyInfo& property);
+    std::string GetAccessorName(const PropertyInfo& property, const std::string& prefix = "Get");
     
     // Serialization generation
+    void WriteSchema(std::ofstream& file, const ClassInfo& classInfo);
     void WriteSerializationCode(std::ofstream& file, const ClassInfo& classInfo);
     void WriteDeserializationCode(std::ofstream& file, const ClassInfo& classInfo);
+    std::vector<std::vector<const PropertyInfo*>> GetSerializationRuns(const ClassInfo& classInfo);
+    std::string GetRunCondition(const ClassInfo& classInfo, const std::vector<const PropertyInfo*>& run,
+                                size_t indent = 0, const std::string& trait = "IsBulkCopyable");
+    std::string GetRunSize(const ClassInfo& classInfo, const std::vector<const PropertyInfo*>& run);
+    std::string GetBaseCall(const ClassInfo& classInfo, const std::string& fallback, const std::string& parameters,
+                            const std::string& call, const std::string& objects = "");
     
     // Utility methods
     std::string GetPropertyFlagsString(const PropertyInfo& property);
@@ -77,6 +210,14 @@ private:
     std::string GetClassFlagsString(const ClassInfo& classInfo);
     std::string GetTypeRegistrationName(const std::string& typeName);
     std::string GetPropertyTypeName(const std::string& typeName);
+    bool HasExtensionHeader(const ClassInfo& classInfo);
+    bool HasBatchFunctions(const ClassInfo& classInfo);
+    bool HasCompactFunctions(const ClassInfo& classInfo);
+    bool HasDeltaFunctions(const ClassInfo& classInfo);
+    bool HasSerializedProperties(const ClassInfo& classInfo);
+    std::vector<const PropertyInfo*> GetSerializedProperties(const ClassInfo& classInfo);
+    bool IsPropertyIncluded(const PropertyInfo& property);
+    bool IsPropertySerialized(const PropertyInfo& property);
     
     // File system helpers
     void EnsureDirectoryExists(const std::string& path);
@@ -70,8 +70,25 @@ bool FileScanner::ShouldProcessFile(const std::string& filePath) {
         return false;
     }
     
-    // Check if file contains reflection macros
-    return ContainsReflectionMacros(filePath);
+    // Check if file contains reflection macros, reusing the previous answer for unchanged files
+    std::error_code error;
+    auto writeTime = std::filesystem::last_write_time(path, error);
+    if (error) {
+        return ContainsReflectionMacros(filePath);
+    }
+
+    auto it = m_macroCache.find(filePath);
+    if (it != m_macroCache.end() && it->second.writeTime == writeTime) {
+        return it->second.containsMacros;
+    }
+
+    bool containsMacros = ContainsReflectionMacros(filePath);
+    m_macroCache[filePath] = CachedMacroCheck{writeTime, containsMacros};
+    return containsMacros;
+}
+
+void FileScanner::ClearCache() {
+    m_macroCache.clear();
 }
 
 std::vector<std::string> FileScanner::GetHeaderFiles(
@@ -3,11 +3,14 @@
 #include <string>
 #include <vector>
 #include <filesystem>
+#include <unordered_map>
 
 namespace ReflectionGenerator {
 
 /**
- * Scans directories for C++ header files that might contain reflection-enabled classes
+ * Scans directories for C++ header files that might contain reflection-enabled classes.
+ * The result of the macro check is cached by modification time, so repeated scans of
+ * the same tree only re-read files that changed.
  */
 class FileScanner {
 public:
@@ -39,6 +42,11 @@ public:
         const std::vector<std::string>& extensions = {".h", ".hpp"}
     );
 
+    /**
+     * Forget all cached macro checks
+     */
+    void ClearCache();
+
 private:
     /**
      * Check if a file contains reflection macros
@@ -54,6 +62,16 @@ private:
      */
     bool ShouldExcludeDirectory(const std::string& dirPath);
 
+    /**
+     * Result of a macro check together with the file time it was computed for
+     */
+    struct CachedMacroCheck {
+        std::filesystem::file_time_type writeTime;
+        bool containsMacros = false;
+    };
+
+    std::unordered_map<std::string, CachedMacroCheck> m_macroCache;
+
     // Common directories to exclude
     static const std::vector<std::string> s_excludedDirectories;
     static const std::vector<std::string> s_headerExtensions;
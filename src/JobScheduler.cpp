@@ -0,0 +1,236 @@
+#include "JobScheduler.h"
+#include <algorithm>
+#include <cctype>
+#include <chrono>
+#include <exception>
+#include <fstream>
+#include <thread>
+
+#if defined(_WIN32)
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#include <psapi.h>
+#elif defined(__APPLE__)
+#include <mach/mach.h>
+#elif defined(__linux__)
+#include <unistd.h>
+#endif
+
+#if defined(__GLIBC__)
+#include <malloc.h>
+#endif
+
+namespace ReflectionGenerator {
+
+namespace {
+
+// How often waiting workers re-sample the process memory
+constexpr auto kSampleInterval = std::chrono::milliseconds(50);
+
+// Minimum time between two admissions under a memory budget, so that the
+// memory of the last admitted job shows up in the RSS before the next decision
+constexpr auto kRampInterval = std::chrono::milliseconds(250);
+
+} // namespace
+
+JobScheduler::JobScheduler(const SchedulerOptions& options)
+    : m_options(options) {
+}
+
+void JobScheduler::Run(const std::vector<std::string>& items, const Job& job) {
+    m_workerCount = 0;
+    if (items.empty()) {
+        return;
+    }
+
+    unsigned maxWorkers = m_options.maxWorkers;
+    if (maxWorkers == 0) {
+        maxWorkers = std::max(1u, std::thread::hardware_concurrency());
+    }
+    maxWorkers = static_cast<unsigned>(std::min<size_t>(maxWorkers, items.size()));
+    m_workerCount = maxWorkers;
+
+    size_t nextItem = 0;
+    std::exception_ptr firstError;
+    auto runStart = std::chrono::steady_clock::now();
+    auto lastAdmission = runStart - kRampInterval;
+
+    m_running = 0;
+    m_peakConcurrency = 0;
+    m_baselineMemory = GetProcessMemoryUsage();
+    m_jobMemoryEstimate = 0;
+    m_records.clear();
+    m_records.reserve(items.size());
+
+    auto secondsSinceStart = [&runStart]() {
+        return std::chrono::duration<double>(std::chrono::steady_clock::now() - runStart).count();
+    };
+
+    auto worker = [&](unsigned workerIndex) {
+        std::unique_lock<std::mutex> lock(m_mutex);
+
+        for (;;) {
+            // Wait until the memory budget admits another job
+            for (;;) {
+                if (nextItem >= items.size()) {
+                    return;
+                }
+
+                size_t currentMemory = GetProcessMemoryUsage();
+                UpdateMemoryEstimate(currentMemory);
+
+                bool rampedUp = std::chrono::steady_clock::now() - lastAdmission >= kRampInterval;
+                if (CanAdmitJob(currentMemory, rampedUp)) {
+                    break;
+                }
+
+                m_jobFinished.wait_for(lock, kSampleInterval);
+            }
+
+            const std::string& item = items[nextItem++];
+            lastAdmission = std::chrono::steady_clock::now();
+            m_peakConcurrency = std::max(m_peakConcurrency, ++m_running);
+
+            JobRecord record;
+            record.item = item;
+            record.worker = workerIndex;
+            record.startSeconds = secondsSinceStart();
+
+            lock.unlock();
+            try {
+                job(item);
+            }
+            catch (...) {
+                std::lock_guard<std::mutex> errorLock(m_mutex);
+                if (!firstError) {
+                    firstError = std::current_exception();
+                }
+            }
+            ReleaseFreedMemory();
+            lock.lock();
+
+            record.endSeconds = secondsSinceStart();
+            m_records.push_back(std::move(record));
+
+            --m_running;
+            if (m_running == 0) {
+                m_baselineMemory = std::min(m_baselineMemory, GetProcessMemoryUsage());
+            }
+            m_jobFinished.notify_all();
+        }
+    };
+
+    std::vector<std::thread> workers;
+    workers.reserve(maxWorkers);
+    for (unsigned i = 0; i < maxWorkers; ++i) {
+        workers.emplace_back(worker, i);
+    }
+
+    for (auto& thread : workers) {
+        thread.join();
+    }
+
+    if (firstError) {
+        std::rethrow_exception(firstError);
+    }
+}
+
+bool JobScheduler::CanAdmitJob(size_t currentMemory, bool rampedUp) const {
+    // Always keep at least one job running so that progress is guaranteed
+    if (m_running == 0) {
+        return true;
+    }
+
+    if (m_options.maxMemoryBytes == 0) {
+        return true;
+    }
+
+    // Without a usable RSS reading fall back to a single job
+    if (currentMemory == 0) {
+        return false;
+    }
+
+    if (!rampedUp) {
+        return false;
+    }
+
+    return currentMemory + m_jobMemoryEstimate <= m_options.maxMemoryBytes;
+}
+
+void JobScheduler::UpdateMemoryEstimate(size_t currentMemory) {
+    if (m_running == 0 || currentMemory <= m_baselineMemory) {
+        return;
+    }
+
+    // Attribute the growth over the idle baseline evenly to the running jobs
+    // and keep the largest footprint seen so far
+    size_t perJob = (currentMemory - m_baselineMemory) / m_running;
+    m_jobMemoryEstimate = std::max(m_jobMemoryEstimate, perJob);
+}
+
+void JobScheduler::ReleaseFreedMemory() {
+#if defined(__GLIBC__)
+    // Hand freed Clang arenas back to the OS so the RSS reflects live jobs only
+    malloc_trim(0);
+#endif
+}
+
+size_t JobScheduler::GetProcessMemoryUsage() {
+#if defined(_WIN32)
+    PROCESS_MEMORY_COUNTERS counters;
+    if (GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters))) {
+        return counters.WorkingSetSize;
+    }
+    return 0;
+#elif defined(__APPLE__)
+    mach_task_basic_info info;
+    mach_msg_type_number_t count = MACH_TASK_BASIC_INFO_COUNT;
+    if (task_info(mach_task_self(), MACH_TASK_BASIC_INFO,
+                  reinterpret_cast<task_info_t>(&info), &count) == KERN_SUCCESS) {
+        return info.resident_size;
+    }
+    return 0;
+#elif defined(__linux__)
+    std::ifstream statm("/proc/self/statm");
+    size_t totalPages = 0;
+    size_t residentPages = 0;
+    if (statm >> totalPages >> residentPages) {
+        return residentPages * static_cast<size_t>(sysconf(_SC_PAGESIZE));
+    }
+    return 0;
+#else
+    return 0;
+#endif
+}
+
+size_t JobScheduler::ParseMemorySize(const std::string& text) {
+    size_t pos = 0;
+    unsigned long long value = 0;
+    try {
+        value = std::stoull(text, &pos);
+    }
+    catch (const std::exception&) {
+        return 0;
+    }
+
+    std::string suffix = text.substr(pos);
+    std::transform(suffix.begin(), suffix.end(), suffix.begin(), ::toupper);
+
+    if (suffix.empty() || suffix == "B") {
+        return static_cast<size_t>(value);
+    }
+    if (suffix == "K" || suffix == "KB") {
+        return static_cast<size_t>(value) << 10;
+    }
+    if (suffix == "M" || suffix == "MB") {
+        return static_cast<size_t>(value) << 20;
+    }
+    if (suffix == "G" || suffix == "GB") {
+        return static_cast<size_t>(value) << 30;
+    }
+    return 0;
+}
+
+} // namespace ReflectionGenerator
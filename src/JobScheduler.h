@@ -0,0 +1,108 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include <functional>
+#include <mutex>
+#include <condition_variable>
+#include <cstddef>
+
+namespace ReflectionGenerator {
+
+/**
+ * Limits for the parse job scheduler
+ */
+struct SchedulerOptions {
+    // Upper bound for the resident set size of the whole process, 0 means unlimited
+    size_t maxMemoryBytes = 0;
+
+    // Upper bound for concurrently running jobs, 0 means hardware concurrency
+    unsigned maxWorkers = 0;
+};
+
+/**
+ * Timing of a single finished job, relative to the start of the run
+ */
+struct JobRecord {
+    std::string item;
+    unsigned worker = 0;
+    double startSeconds = 0.0;
+    double endSeconds = 0.0;
+
+    double GetDuration() const { return endSeconds - startSeconds; }
+};
+
+/**
+ * Runs parse jobs on worker threads while keeping the process memory under a budget.
+ *
+ * Concurrency is not fixed: the scheduler samples the process RSS, learns how much
+ * memory a single job needs, and only admits another job while the current RSS plus
+ * that estimate stays under the budget. At least one job is always allowed to run.
+ */
+class JobScheduler {
+public:
+    using Job = std::function<void(const std::string& item)>;
+
+    explicit JobScheduler(const SchedulerOptions& options = {});
+    ~JobScheduler() = default;
+
+    /**
+     * Run a job for every item and wait for all of them to finish
+     * @param items Work items (file paths) in the order they should be started
+     * @param job Callback executed on a worker thread for each item
+     */
+    void Run(const std::vector<std::string>& items, const Job& job);
+
+    /**
+     * Get the highest number of jobs that were running at the same time during the last Run
+     */
+    unsigned GetPeakConcurrency() const { return m_peakConcurrency; }
+
+    /**
+     * Get the number of worker threads spawned by the last Run
+     */
+    unsigned GetWorkerCount() const { return m_workerCount; }
+
+    /**
+     * Get start and end times of every job of the last Run, in completion order
+     */
+    const std::vector<JobRecord>& GetJobRecords() const { return m_records; }
+
+    /**
+     * Get the learned memory footprint of a single job in bytes
+     */
+    size_t GetJobMemoryEstimate() const { return m_jobMemoryEstimate; }
+
+    /**
+     * Get the current resident set size of this process
+     * @return RSS in bytes, or 0 if it cannot be determined on this platform
+     */
+    static size_t GetProcessMemoryUsage();
+
+    /**
+     * Parse a memory size such as "512M", "8G" or "1048576"
+     * @param text Size with an optional K/M/G suffix
+     * @return Size in bytes, or 0 if the text is not a valid size
+     */
+    static size_t ParseMemorySize(const std::string& text);
+
+private:
+    SchedulerOptions m_options;
+
+    std::mutex m_mutex;
+    std::condition_variable m_jobFinished;
+
+    unsigned m_running = 0;
+    unsigned m_peakConcurrency = 0;
+    unsigned m_workerCount = 0;
+    size_t m_baselineMemory = 0;
+    size_t m_jobMemoryEstimate = 0;
+    std::vector<JobRecord> m_records;
+
+    // Helper methods
+    bool CanAdmitJob(size_t currentMemory, bool rampedUp) const;
+    void UpdateMemoryEstimate(size_t currentMemory);
+    static void ReleaseFreedMemory();
+};
+
+} // namespace ReflectionGenerator
@@ -0,0 +1,192 @@
+#include "JobTimings.h"
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+
+namespace ReflectionGenerator {
+
+namespace {
+
+// Every direct include is weighted like this many kilobytes of source, since the
+// headers it pulls in (GLM, ASSIMP, ...) dominate the parse time
+constexpr double kIncludeCostUnits = 64.0;
+
+// Fallback cost per unit when there is no history to calibrate against
+constexpr double kDefaultSecondsPerCostUnit = 0.002;
+
+} // namespace
+
+const char* JobTimings::s_timingFileName = ".reflect_gen_timings";
+
+JobTimings::JobTimings(const std::string& outputDir)
+    : m_timingFile((std::filesystem::path(outputDir) / s_timingFileName).string())
+    , m_secondsPerCostUnit(kDefaultSecondsPerCostUnit) {
+}
+
+bool JobTimings::Load() {
+    std::ifstream file(m_timingFile);
+    if (!file.is_open()) {
+        return false;
+    }
+
+    // Each line: <seconds> <file size> <include count> <path>
+    std::string line;
+    while (std::getline(file, line)) {
+        std::istringstream stream(line);
+        FileTiming timing;
+        std::string path;
+        if (stream >> timing.seconds >> timing.fileSize >> timing.includeCount) {
+            std::getline(stream >> std::ws, path);
+            if (!path.empty()) {
+                m_timings[path] = timing;
+            }
+        }
+    }
+
+    CalibrateSecondsPerCostUnit();
+    return true;
+}
+
+void JobTimings::Save() const {
+    std::ofstream file(m_timingFile);
+    if (!file.is_open()) {
+        return;
+    }
+
+    file << std::setprecision(6);
+    for (const auto& [path, timing] : m_timings) {
+        file << timing.seconds << " " << timing.fileSize << " " << timing.includeCount << " " << path << "\n";
+    }
+}
+
+double JobTimings::GetEstimate(const std::string& filePath) const {
+    auto it = m_timings.find(filePath);
+    if (it != m_timings.end()) {
+        return it->second.seconds;
+    }
+
+    return GetCostUnits(GetFileSize(filePath), CountIncludes(filePath)) * m_secondsPerCostUnit;
+}
+
+std::vector<std::string> JobTimings::OrderLongestFirst(const std::vector<std::string>& filePaths) const {
+    std::vector<std::pair<double, std::string>> estimated;
+    estimated.reserve(filePaths.size());
+    for (const auto& filePath : filePaths) {
+        estimated.emplace_back(GetEstimate(filePath), filePath);
+    }
+
+    std::stable_sort(estimated.begin(), estimated.end(),
+                     [](const auto& a, const auto& b) { return a.first > b.first; });
+
+    std::vector<std::string> result;
+    result.reserve(estimated.size());
+    for (auto& entry : estimated) {
+        result.push_back(std::move(entry.second));
+    }
+    return result;
+}
+
+void JobTimings::Record(const std::vector<JobRecord>& records) {
+    for (const auto& record : records) {
+        FileTiming timing;
+        timing.seconds = record.GetDuration();
+        timing.fileSize = GetFileSize(record.item);
+        timing.includeCount = CountIncludes(record.item);
+        m_timings[record.item] = timing;
+    }
+
+    CalibrateSecondsPerCostUnit();
+}
+
+void JobTimings::WriteTrace(std::ostream& out,
+                            const std::vector<std::string>& filePaths,
+                            const std::vector<JobRecord>& records,
+                            unsigned workers) const {
+    // Size the lanes from the records as well, so no finished job falls off the trace
+    workers = std::max(1u, workers);
+    for (const auto& record : records) {
+        workers = std::max(workers, record.worker + 1);
+    }
+
+    // Expected: list scheduling of the estimates onto the least loaded worker
+    std::vector<double> expectedLoad(workers, 0.0);
+    std::vector<std::vector<std::pair<std::string, double>>> expectedLanes(workers);
+    for (const auto& filePath : filePaths) {
+        auto lane = std::min_element(expectedLoad.begin(), expectedLoad.end()) - expectedLoad.begin();
+        double estimate = GetEstimate(filePath);
+        expectedLoad[lane] += estimate;
+        expectedLanes[lane].emplace_back(filePath, estimate);
+    }
+    size_t expectedCritical = std::max_element(expectedLoad.begin(), expectedLoad.end()) - expectedLoad.begin();
+
+    // Actual: the worker whose last job finished last
+    std::vector<double> actualEnd(workers, 0.0);
+    std::vector<std::vector<const JobRecord*>> actualLanes(workers);
+    for (const auto& record : records) {
+        actualEnd[record.worker] = std::max(actualEnd[record.worker], record.endSeconds);
+        actualLanes[record.worker].push_back(&record);
+    }
+    size_t actualCritical = std::max_element(actualEnd.begin(), actualEnd.end()) - actualEnd.begin();
+
+    out << std::fixed << std::setprecision(3);
+    out << "Critical path (expected): " << expectedLoad[expectedCritical] << "s on worker "
+        << expectedCritical << "\n";
+    for (const auto& [filePath, estimate] : expectedLanes[expectedCritical]) {
+        out << "  " << std::setw(9) << estimate << "s  " << filePath << "\n";
+    }
+
+    out << "Critical path (actual):   " << actualEnd[actualCritical] << "s on worker "
+        << actualCritical << "\n";
+    for (const auto* record : actualLanes[actualCritical]) {
+        out << "  " << std::setw(9) << record->GetDuration() << "s  " << record->item
+            << " (expected " << GetEstimate(record->item) << "s)\n";
+    }
+    out << std::defaultfloat;
+}
+
+double JobTimings::GetCostUnits(uintmax_t fileSize, size_t includeCount) const {
+    return static_cast<double>(fileSize) / 1024.0 + static_cast<double>(includeCount) * kIncludeCostUnits;
+}
+
+void JobTimings::CalibrateSecondsPerCostUnit() {
+    // Calibrate against the files measured by previous runs
+    double seconds = 0.0;
+    double units = 0.0;
+    for (const auto& [path, timing] : m_timings) {
+        seconds += timing.seconds;
+        units += GetCostUnits(timing.fileSize, timing.includeCount);
+    }
+
+    m_secondsPerCostUnit = units > 0.0 ? seconds / units : kDefaultSecondsPerCostUnit;
+}
+
+size_t JobTimings::CountIncludes(const std::string& filePath) {
+    std::ifstream file(filePath);
+    if (!file.is_open()) {
+        return 0;
+    }
+
+    size_t count = 0;
+    std::string line;
+    while (std::getline(file, line)) {
+        size_t start = line.find_first_not_of(" \t");
+        if (start == std::string::npos || line[start] != '#') {
+            continue;
+        }
+        size_t directive = line.find_first_not_of(" \t", start + 1);
+        if (directive != std::string::npos && line.compare(directive, 7, "include") == 0) {
+            count++;
+        }
+    }
+    return count;
+}
+
+uintmax_t JobTimings::GetFileSize(const std::string& filePath) {
+    std::error_code error;
+    auto size = std::filesystem::file_size(filePath, error);
+    return error ? 0 : size;
+}
+
+} // namespace ReflectionGenerator
@@ -0,0 +1,89 @@
+#pragma once
+
+#include "JobScheduler.h"
+#include <string>
+#include <vector>
+#include <unordered_map>
+#include <ostream>
+#include <cstdint>
+
+namespace ReflectionGenerator {
+
+/**
+ * Parse duration of a file recorded by a previous run
+ */
+struct FileTiming {
+    double seconds = 0.0;
+    uintmax_t fileSize = 0;
+    size_t includeCount = 0;
+};
+
+/**
+ * Persists per-file parse durations between runs and uses them to order the work queue
+ * longest-processing-time first, so heavy headers do not end up at the tail of a parallel run.
+ */
+class JobTimings {
+public:
+    explicit JobTimings(const std::string& outputDir);
+    ~JobTimings() = default;
+
+    /**
+     * Load timings recorded by previous runs
+     * @return True if a timing file was found and read
+     */
+    bool Load();
+
+    /**
+     * Write the recorded timings next to the generated files
+     */
+    void Save() const;
+
+    /**
+     * Get the expected parse duration of a file
+     * @param filePath Path to the file
+     * @return Recorded duration, or an estimate from file size and include count for unseen files
+     */
+    double GetEstimate(const std::string& filePath) const;
+
+    /**
+     * Sort files so that the most expensive ones are started first
+     * @param filePaths Files to order
+     * @return Files ordered by descending expected duration
+     */
+    std::vector<std::string> OrderLongestFirst(const std::vector<std::string>& filePaths) const;
+
+    /**
+     * Store the measured durations of a finished run
+     * @param records Job records reported by the scheduler
+     */
+    void Record(const std::vector<JobRecord>& records);
+
+    /**
+     * Print the expected critical path (from estimates) next to the actual one (from records)
+     * @param out Output stream
+     * @param filePaths Files in scheduling order
+     * @param records Job records reported by the scheduler
+     * @param workers Number of workers the run spawned
+     */
+    void WriteTrace(std::ostream& out,
+                    const std::vector<std::string>& filePaths,
+                    const std::vector<JobRecord>& records,
+                    unsigned workers) const;
+
+private:
+    std::string m_timingFile;
+    std::unordered_map<std::string, FileTiming> m_timings;
+
+    // Calibrated once whenever the timings change, not per estimate
+    double m_secondsPerCostUnit = 0.0;
+
+    // Helper methods
+    double GetCostUnits(uintmax_t fileSize, size_t includeCount) const;
+    void CalibrateSecondsPerCostUnit();
+    static size_t CountIncludes(const std::string& filePath);
+    static uintmax_t GetFileSize(const std::string& filePath);
+
+    static const char* s_timingFileName;
+};
+
+} // namespace ReflectionGenerator
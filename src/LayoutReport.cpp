@@ -0,0 +1,174 @@
+#include "LayoutReport.h"
+#include <algorithm>
+#include <fstream>
+#include <iostream>
+#include <set>
+#include <sstream>
+
+namespace ReflectionGenerator {
+
+void LayoutReport::AddClass(const ClassInfo& classInfo) {
+    if (classInfo.size == 0) {
+        return;
+    }
+
+    LayoutAnalysis analysis = Analyze(classInfo);
+    std::string name = classInfo.qualifiedName.empty() ? classInfo.name : classInfo.qualifiedName;
+
+    std::ostringstream section;
+    section << "## " << name << "\n\n";
+    section << "- Size: " << analysis.size << " bytes, alignment " << classInfo.alignment << "\n";
+    section << "- Padding: " << analysis.paddingBytes << " bytes\n";
+
+    if (!analysis.straddlingFields.empty()) {
+        section << "- Fields straddling cache lines:";
+        for (const auto* field : analysis.straddlingFields) {
+            section << " " << field->name << " (offset " << field->offset << ", size " << field->size << ")";
+        }
+        section << "\n";
+    }
+
+    if (analysis.saveCacheLines > analysis.minimalSaveCacheLines) {
+        section << "- Save properties are scattered over " << analysis.saveCacheLines
+                << " cache lines, " << analysis.minimalSaveCacheLines << " would suffice\n";
+    }
+
+    section << "\n| Offset | Size | Align | Field | Type |\n";
+    section << "|-------:|-----:|------:|-------|------|\n";
+    for (const auto& field : classInfo.fields) {
+        section << "| " << field.offset << " | " << field.size << " | " << field.alignment << " | "
+                << field.name << (field.save ? " [Save]" : "") << (field.bitField ? " [bit-field]" : "")
+                << " | `" << field.type << "` |\n";
+    }
+
+    if (analysis.suggestedSize < analysis.size) {
+        section << "\nSuggested order (" << analysis.suggestedSize << " bytes, saves "
+                << analysis.size - analysis.suggestedSize << "):\n\n";
+        for (const auto* field : analysis.suggestedOrder) {
+            section << "1. `" << field->type << " " << field->name << "`\n";
+        }
+        m_totalSavingBytes += analysis.size - analysis.suggestedSize;
+    }
+    section << "\n";
+
+    m_sections[name] = section.str();
+    m_classCount++;
+    if (analysis.paddingBytes > 0) {
+        m_paddedClassCount++;
+        m_totalPaddingBytes += analysis.paddingBytes;
+    }
+}
+
+bool LayoutReport::Write(const std::string& outputPath) const {
+    std::ofstream file(outputPath);
+    if (!file.is_open()) {
+        std::cerr << "Error: Cannot open file for writing: " << outputPath << "\n";
+        return false;
+    }
+
+    file << "# Reflection Layout Report\n\n";
+    file << "Cache line size: " << kCacheLineSize
+         << " bytes. Objects are assumed to start on a cache line boundary.\n\n";
+    file << "- Classes: " << m_classCount << "\n";
+    file << "- Classes with padding: " << m_paddedClassCount << "\n";
+    file << "- Total padding: " << m_totalPaddingBytes << " bytes\n";
+    file << "- Saved by suggested orders: " << m_totalSavingBytes << " bytes\n\n";
+
+    for (const auto& [name, section] : m_sections) {
+        file << section;
+    }
+
+    return true;
+}
+
+LayoutAnalysis LayoutReport::Analyze(const ClassInfo& classInfo) {
+    LayoutAnalysis analysis;
+    analysis.size = classInfo.size;
+
+    // Padding is every byte not covered by the bases or a field
+    std::vector<bool> occupied(classInfo.size, false);
+    std::fill(occupied.begin(), occupied.begin() + std::min(classInfo.baseSize, classInfo.size), true);
+    for (const auto& field : classInfo.fields) {
+        size_t end = std::min(field.offset + field.size, classInfo.size);
+        for (size_t i = field.offset; i < end; ++i) {
+            occupied[i] = true;
+        }
+    }
+    analysis.paddingBytes = static_cast<size_t>(std::count(occupied.begin(), occupied.end(), false));
+
+    // Fields that fit into a cache line but are split across two
+    for (const auto& field : classInfo.fields) {
+        if (!field.bitField && field.size > 0 && field.size <= kCacheLineSize &&
+            GetFirstCacheLine(field) != GetLastCacheLine(field)) {
+            analysis.straddlingFields.push_back(&field);
+        }
+    }
+
+    // Save properties: cache lines touched versus the minimum needed
+    std::set<size_t> saveLines;
+    size_t saveBytes = 0;
+    for (const auto& field : classInfo.fields) {
+        if (!field.save || field.size == 0) {
+            continue;
+        }
+        saveBytes += field.size;
+        for (size_t line = GetFirstCacheLine(field); line <= GetLastCacheLine(field); ++line) {
+            saveLines.insert(line);
+        }
+    }
+    analysis.saveCacheLines = saveLines.size();
+    analysis.minimalSaveCacheLines = (saveBytes + kCacheLineSize - 1) / kCacheLineSize;
+
+    // Suggested order: decreasing alignment, Save fields grouped first within an
+    // alignment class, then decreasing size. Bit-fields keep their relative order at the end.
+    std::vector<const FieldLayout*> movable;
+    std::vector<const FieldLayout*> bitFields;
+    for (const auto& field : classInfo.fields) {
+        (field.bitField ? bitFields : movable).push_back(&field);
+    }
+    std::stable_sort(movable.begin(), movable.end(), [](const FieldLayout* a, const FieldLayout* b) {
+        if (a->alignment != b->alignment) return a->alignment > b->alignment;
+        if (a->save != b->save) return a->save;
+        return a->size > b->size;
+    });
+
+    size_t offset = classInfo.baseSize;
+    for (const auto* field : movable) {
+        offset = AlignUp(offset, field->alignment) + field->size;
+    }
+
+    // Bit-fields sharing storage are counted once
+    size_t bitFieldBytes = 0;
+    std::set<size_t> bitFieldOffsets;
+    for (const auto* field : bitFields) {
+        for (size_t i = 0; i < field->size; ++i) {
+            if (bitFieldOffsets.insert(field->offset + i).second) {
+                bitFieldBytes++;
+            }
+        }
+    }
+    offset += bitFieldBytes;
+
+    analysis.suggestedOrder = movable;
+    analysis.suggestedOrder.insert(analysis.suggestedOrder.end(), bitFields.begin(), bitFields.end());
+    analysis.suggestedSize = AlignUp(std::max<size_t>(offset, 1), classInfo.alignment);
+
+    return analysis;
+}
+
+size_t LayoutReport::AlignUp(size_t value, size_t alignment) {
+    if (alignment <= 1) {
+        return value;
+    }
+    return (value + alignment - 1) / alignment * alignment;
+}
+
+size_t LayoutReport::GetFirstCacheLine(const FieldLayout& field) {
+    return field.offset / kCacheLineSize;
+}
+
+size_t LayoutReport::GetLastCacheLine(const FieldLayout& field) {
+    return (field.offset + std::max<size_t>(field.size, 1) - 1) / kCacheLineSize;
+}
+
+} // namespace ReflectionGenerator
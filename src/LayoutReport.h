@@ -0,0 +1,72 @@
+#pragma once
+
+#include "ReflectionAST.h"
+#include <string>
+#include <vector>
+#include <map>
+
+namespace ReflectionGenerator {
+
+/**
+ * Layout analysis of a single reflection-enabled class
+ */
+struct LayoutAnalysis {
+    size_t size = 0;
+    size_t paddingBytes = 0;
+    std::vector<const FieldLayout*> straddlingFields;
+
+    // Field order that minimizes padding, and the class size it would result in
+    std::vector<const FieldLayout*> suggestedOrder;
+    size_t suggestedSize = 0;
+
+    // Cache lines touched by Save properties versus the minimum they would need
+    size_t saveCacheLines = 0;
+    size_t minimalSaveCacheLines = 0;
+};
+
+/**
+ * Collects size, padding and cache line usage of reflection-enabled classes and
+ * writes them as a report together with padding-minimizing field orders
+ */
+class LayoutReport {
+public:
+    static constexpr size_t kCacheLineSize = 64;
+
+    LayoutReport() = default;
+    ~LayoutReport() = default;
+
+    /**
+     * Analyze a class and keep its report section
+     * @param classInfo Class information including its record layout
+     */
+    void AddClass(const ClassInfo& classInfo);
+
+    /**
+     * Write the report for all added classes
+     * @param outputPath Output file path
+     * @return True if the report was written
+     */
+    bool Write(const std::string& outputPath) const;
+
+    /**
+     * Analyze the layout of a class
+     * @param classInfo Class information including its record layout
+     * @return Padding, cache line and reordering information
+     */
+    static LayoutAnalysis Analyze(const ClassInfo& classInfo);
+
+private:
+    // Report sections keyed by qualified class name, so the output is stable
+    std::map<std::string, std::string> m_sections;
+    size_t m_classCount = 0;
+    size_t m_paddedClassCount = 0;
+    size_t m_totalPaddingBytes = 0;
+    size_t m_totalSavingBytes = 0;
+
+    // Helper methods
+    static size_t AlignUp(size_t value, size_t alignment);
+    static size_t GetFirstCacheLine(const FieldLayout& field);
+    static size_t GetLastCacheLine(const FieldLayout& field);
+};
+
+} // namespace ReflectionGenerator
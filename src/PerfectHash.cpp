@@ -0,0 +1,76 @@
+#include "PerfectHash.h"
+#include "ReflectionRuntime/NameHash.h"
+#include <algorithm>
+#include <numeric>
+
+namespace ReflectionGenerator {
+
+bool PerfectHash::Build(const std::vector<std::string>& names, PerfectHashTable& table) {
+    const size_t count = names.size();
+    table.displacements.assign(count, 0);
+    table.slots.assign(count, 0);
+    if (count == 0) {
+        return true;
+    }
+    
+    // Distribute the names into one bucket per slot with the first hash
+    std::vector<std::vector<size_t>> buckets(count);
+    for (size_t i = 0; i < count; ++i) {
+        buckets[ReflectionRuntime::HashName(names[i], 0) % count].push_back(i);
+    }
+    
+    // Place the largest buckets first, while most slots are still free
+    std::vector<size_t> order(count);
+    std::iota(order.begin(), order.end(), 0);
+    std::stable_sort(order.begin(), order.end(), [&buckets](size_t a, size_t b) {
+        return buckets[a].size() > buckets[b].size();
+    });
+    
+    std::vector<bool> occupied(count, false);
+    std::vector<size_t> candidate;
+    size_t bucketIndex = 0;
+    
+    for (; bucketIndex < order.size() && buckets[order[bucketIndex]].size() > 1; ++bucketIndex) {
+        const auto& bucket = buckets[order[bucketIndex]];
+        bool placed = false;
+        
+        for (int32_t displacement = 1; displacement < kMaxDisplacement && !placed; ++displacement) {
+            candidate.clear();
+            for (size_t key : bucket) {
+                size_t slot = ReflectionRuntime::HashName(names[key], static_cast<uint64_t>(displacement)) % count;
+                if (occupied[slot] || std::find(candidate.begin(), candidate.end(), slot) != candidate.end()) {
+                    break;
+                }
+                candidate.push_back(slot);
+            }
+            
+            if (candidate.size() == bucket.size()) {
+                for (size_t i = 0; i < bucket.size(); ++i) {
+                    occupied[candidate[i]] = true;
+                    table.slots[candidate[i]] = static_cast<uint16_t>(bucket[i]);
+                }
+                table.displacements[order[bucketIndex]] = displacement;
+                placed = true;
+            }
+        }
+        
+        if (!placed) {
+            return false;
+        }
+    }
+    
+    // Single names go straight into the remaining free slots
+    size_t freeSlot = 0;
+    for (; bucketIndex < order.size() && buckets[order[bucketIndex]].size() == 1; ++bucketIndex) {
+        while (occupied[freeSlot]) {
+            freeSlot++;
+        }
+        occupied[freeSlot] = true;
+        table.slots[freeSlot] = static_cast<uint16_t>(buckets[order[bucketIndex]][0]);
+        table.displacements[order[bucketIndex]] = -static_cast<int32_t>(freeSlot) - 1;
+    }
+    
+    return true;
+}
+
+} // namespace ReflectionGenerator
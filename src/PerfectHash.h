@@ -0,0 +1,38 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include <cstdint>
+
+namespace ReflectionGenerator {
+
+/**
+ * Minimal perfect hash table over a set of names, in the layout expected by
+ * ReflectionRuntime::NameIndex
+ */
+struct PerfectHashTable {
+    // One per bucket: negative values are -slot - 1, others the seed of the second hash
+    std::vector<int32_t> displacements;
+
+    // Position of each slot in the key list passed to Build
+    std::vector<uint16_t> slots;
+};
+
+/**
+ * Builds minimal perfect hash tables with hash-and-displace
+ */
+class PerfectHash {
+public:
+    /**
+     * Build a table over distinct names
+     * @param names Names to hash, must not contain duplicates
+     * @param table Receives the displacements and slot order
+     * @return False if no displacement could be found within the search limit
+     */
+    static bool Build(const std::vector<std::string>& names, PerfectHashTable& table);
+
+private:
+    static constexpr int32_t kMaxDisplacement = 1 << 20;
+};
+
+} // namespace ReflectionGenerator
@@ -7,6 +7,28 @@
 
 namespace ReflectionGenerator {
 
+/**
+ * Kind of value a property holds, for generated code that treats them differently
+ */
+enum class PropertyKind {
+    Other,
+    Bool,
+    Integer,
+    Float,
+    Enum,
+    String,
+    Vector
+};
+
+/**
+ * Where the generated factory of a class allocates its instances
+ */
+enum class AllocationMode {
+    Heap,   // std::make_unique
+    Pool,   // Per-type pool that reuses freed slots
+    Arena   // Per-type arena released all at once
+};
+
 /**
  * Represents a property in a reflection-enabled class
  */
@@ -14,7 +36,19 @@ struct PropertyInfo {
     std::string name;
     std::string type;
     std::string qualifiedType;
+    PropertyKind kind = PropertyKind::Other;
+    
+    // Layout in bytes
     size_t offset = 0;
+    size_t size = 0;
+    size_t alignment = 0;
+    
+    // The bytes of the member are its serialized form: trivially copyable and not
+    // a pointer, bool or bit-field
+    bool bulkCopyable = false;
+    
+    // Bit-fields have no address, so no member pointer or offsetof either
+    bool bitField = false;
     
     // Flags from GPROPERTY macro
     bool save = false;
@@ -30,11 +64,30 @@ struct PropertyInfo {
     std::string clampMin;
     std::string clampMax;
     
+    // Bits a clamped float is quantized to in compact serialization, 0 to keep it exact
+    uint32_t quantizeBits = 0;
+    
     // Source location
     std::string fileName;
     int lineNumber = 0;
 };
 
+/**
+ * Memory layout of one data member of a reflection-enabled class, reflected or not
+ */
+struct FieldLayout {
+    std::string name;
+    std::string type;
+    size_t offset = 0;
+    size_t size = 0;
+    size_t alignment = 1;
+    bool bitField = false;
+    
+    // Set when the field is a GPROPERTY
+    bool property = false;
+    bool save = false;
+};
+
 /**
  * Represents a function in a reflection-enabled class
  */
@@ -44,6 +97,11 @@ struct FunctionInfo {
     std::vector<std::string> parameters;
     std::vector<std::string> parameterTypes;
     
+    // Member function pointer type (function pointer type for static functions) with
+    // fully qualified names, for selecting one of several overloads in generated code
+    std::string pointerType;
+    bool isStatic = false;
+    
     // Flags from GFUNCTION macro
     bool callable = false;
     bool blueprintEvent = false;
@@ -58,6 +116,21 @@ struct FunctionInfo {
     int lineNumber = 0;
 };
 
+/**
+ * Compact description of a reflection-enabled class, kept for module-wide steps
+ * after the full ClassInfo has been handed to code generation and released
+ */
+struct ClassSummary {
+    std::string name;
+    std::string qualifiedName;
+    std::string namespaceName;
+    std::string baseClass;
+    std::string reflectedBase;
+    
+    // Source file the class was generated from
+    std::string fileName;
+};
+
 /**
  * Represents a reflection-enabled class
  */
@@ -67,15 +140,40 @@ struct ClassInfo {
     std::string baseClass;
     std::string namespaceName;
     
+    // Qualified name of the base class when it is reflected itself, possibly by another module
+    std::string reflectedBase;
+    
     // Flags from GCLASS macro
     bool blueprintable = false;
     bool serializable = false;
     bool abstract = false;
     bool defaultToInstanced = false;
     
+    // Generate a structure-of-arrays container with one column per property
+    bool soa = false;
+    
+    // Track changed Save properties for delta serialization. dirtyBitsMember is the
+    // ReflectionRuntime::DirtyBits data member holding the bits, empty if there is none.
+    bool replicated = false;
+    std::string dirtyBitsMember;
+    
+    // Allocator of the generated factory
+    AllocationMode allocation = AllocationMode::Heap;
+    
     // Version for serialization
     uint32_t version = 1;
     
+    // Write a field table after the schema fingerprint, so data stays readable after
+    // the Save properties change
+    bool tagged = false;
+    
+    // Record layout in bytes. baseSize covers the vtable pointer and base classes,
+    // i.e. everything in front of the class's own fields.
+    size_t size = 0;
+    size_t alignment = 1;
+    size_t baseSize = 0;
+    std::vector<FieldLayout> fields;
+    
     // Properties and functions
     std::vector<PropertyInfo> properties;
     std::vector<FunctionInfo> functions;
@@ -112,6 +210,10 @@ struct ClassInfo {
         }
         return nullptr;
     }
+    
+    ClassSummary GetSummary() const {
+        return ClassSummary{name, qualifiedName, namespaceName, baseClass, reflectedBase, fileName};
+    }
 };
 
 /**
@@ -121,6 +223,9 @@ struct ReflectionData {
     std::string fileName;
     std::vector<ClassInfo> classes;
     
+    // Every file the translation unit read: the parsed file and all its includes
+    std::vector<std::string> dependencies;
+    
     // Helper methods
     const ClassInfo* GetClass(const std::string& name) const {
         for (const auto& cls : classes) {
@@ -0,0 +1,299 @@
+#include "ReflectionGenerator.h"
+#include "ClassParser.h"
+#include "CodeGenerator.h"
+#include "FileScanner.h"
+#include "JobTimings.h"
+#include "LayoutReport.h"
+#include <iostream>
+#include <algorithm>
+#include <filesystem>
+#include <mutex>
+#include <unordered_map>
+
+namespace ReflectionGenerator {
+
+struct Generator::Impl {
+    /**
+     * Classes parsed from a file, valid while the file, everything it includes and the
+     * compiler flags are unchanged
+     */
+    struct CachedParse {
+        std::vector<std::pair<std::string, std::filesystem::file_time_type>> dependencies;
+        std::string compilerKey;
+        std::vector<ClassInfo> classes;
+    };
+
+    FileScanner scanner;
+
+    std::mutex cacheMutex;
+    std::unordered_map<std::string, CachedParse> parseCache;
+    std::unordered_map<std::string, std::unique_ptr<JobTimings>> timings;
+
+    GenerationResult Run(const GenerationRequest& request);
+    JobTimings& GetTimings(const std::string& outputDir);
+    bool FindCachedClasses(const std::string& filePath, const std::string& compilerKey,
+                           std::vector<ClassInfo>& classes);
+    void StoreCachedClasses(const std::string& filePath, const std::string& compilerKey,
+                            const std::vector<ClassInfo>& classes,
+                            const std::vector<std::string>& dependencies);
+
+    static std::string GetCompilerKey(const GenerationRequest& request);
+    static std::string GetCacheKey(const std::string& filePath);
+};
+
+Generator::Generator()
+    : m_impl(std::make_unique<Impl>()) {
+}
+
+Generator::~Generator() = default;
+
+GenerationResult Generator::Generate(const GenerationRequest& request) {
+    return m_impl->Run(request);
+}
+
+std::vector<GenerationResult> Generator::Generate(const std::vector<GenerationRequest>& requests) {
+    std::vector<GenerationResult> results;
+    results.reserve(requests.size());
+
+    for (const auto& request : requests) {
+        results.push_back(m_impl->Run(request));
+    }
+
+    return results;
+}
+
+void Generator::ClearCaches() {
+    std::lock_guard<std::mutex> lock(m_impl->cacheMutex);
+    m_impl->parseCache.clear();
+    m_impl->timings.clear();
+    m_impl->scanner.ClearCache();
+}
+
+GenerationResult Generator::Impl::Run(const GenerationRequest& request) {
+    GenerationResult result;
+
+    try {
+        // Create output directory
+        std::filesystem::create_directories(request.outputDir);
+
+        ClassParser parser;
+        if (!request.includeDirs.empty()) {
+            parser.SetIncludeDirectories(request.includeDirs);
+        }
+        if (!request.definitions.empty()) {
+            parser.SetDefinitions(request.definitions);
+        }
+
+        // One code generator per output tree, all fed from the same parse. Flavor trees
+        // are subdirectories but belong to the same module.
+        std::vector<std::unique_ptr<CodeGenerator>> generators;
+        if (request.flavors.empty()) {
+            generators.push_back(std::make_unique<CodeGenerator>(request.outputDir, request.generator));
+        } else {
+            for (GenerationFlavor flavor : request.flavors) {
+                GeneratorOptions options = request.generator;
+                options.flavor = flavor;
+                if (options.moduleName.empty()) {
+                    options.moduleName = CodeGenerator::GetDefaultModuleName(request.outputDir);
+                }
+                std::string flavorDir = (std::filesystem::path(request.outputDir) / CodeGenerator::GetFlavorName(flavor)).string();
+                generators.push_back(std::make_unique<CodeGenerator>(flavorDir, options));
+            }
+        }
+
+        std::string compilerKey = GetCompilerKey(request);
+
+        std::vector<std::string> filesToProcess;
+
+        // Collect files to process
+        if (!request.inputFiles.empty()) {
+            filesToProcess = request.inputFiles;
+        } else {
+            for (const auto& dir : request.scanDirs) {
+                if (request.verbose) {
+                    std::cout << "Scanning directory: " << dir << "\n";
+                }
+                auto files = scanner.ScanDirectory(dir);
+                filesToProcess.insert(filesToProcess.end(), files.begin(), files.end());
+            }
+        }
+
+        if (request.verbose) {
+            std::cout << "Found " << filesToProcess.size() << " files to process\n";
+        }
+
+        // Start the files that took longest in previous runs first
+        JobTimings& jobTimings = GetTimings(request.outputDir);
+        filesToProcess = jobTimings.OrderLongestFirst(filesToProcess);
+
+        std::mutex outputMutex;
+        std::vector<ClassSummary> summaries;
+        LayoutReport layoutReport;
+
+        // Process files in parallel, admitting jobs only while the memory budget allows
+        JobScheduler scheduler(request.scheduler);
+        scheduler.Run(filesToProcess, [&](const std::string& filePath) {
+            if (request.verbose) {
+                std::lock_guard<std::mutex> lock(outputMutex);
+                std::cout << "Processing: " << filePath << "\n";
+            }
+
+            try {
+                // In streaming mode nothing is cached, the classes live only until
+                // their code has been generated
+                std::vector<ClassInfo> classes;
+                bool cached = !request.streaming && FindCachedClasses(filePath, compilerKey, classes);
+                if (!cached) {
+                    std::vector<std::string> dependencies;
+                    classes = parser.ParseFile(filePath, dependencies);
+                    if (!request.streaming) {
+                        StoreCachedClasses(filePath, compilerKey, classes, dependencies);
+                    }
+                }
+
+                std::lock_guard<std::mutex> lock(outputMutex);
+                if (!classes.empty()) {
+                    for (auto& generator : generators) {
+                        generator->GenerateCode(filePath, classes);
+                    }
+                    for (const auto& classInfo : classes) {
+                        if (!request.layoutReport.empty()) {
+                            layoutReport.AddClass(classInfo);
+                        }
+
+                        // Generated file names derive from the processed file
+                        ClassSummary summary = classInfo.GetSummary();
+                        summary.fileName = filePath;
+                        summaries.push_back(std::move(summary));
+                    }
+                    result.classesGenerated += static_cast<int>(classes.size());
+                    if (request.verbose) {
+                        std::cout << "  Generated reflection for " << classes.size() << " classes"
+                                  << (cached ? " (cached)" : "") << "\n";
+                    }
+                }
+                result.filesProcessed++;
+                if (cached) {
+                    result.filesFromCache++;
+                }
+            }
+            catch (const std::exception& e) {
+                std::lock_guard<std::mutex> lock(outputMutex);
+                result.errors.push_back("Error processing " + filePath + ": " + e.what());
+                result.success = false;
+            }
+        });
+
+        // Registration only needs the summaries, ordered independently of job completion
+        std::sort(summaries.begin(), summaries.end(), [](const ClassSummary& a, const ClassSummary& b) {
+            return a.qualifiedName < b.qualifiedName;
+        });
+        for (auto& generator : generators) {
+            generator->GenerateModuleRegistration(summaries);
+        }
+
+        if (!request.layoutReport.empty() && !layoutReport.Write(request.layoutReport)) {
+            result.errors.push_back("Error writing layout report: " + request.layoutReport);
+            result.success = false;
+        }
+
+        // Trace before recording, the expected path has to come from the previous runs
+        if (request.trace) {
+            jobTimings.WriteTrace(std::cout, filesToProcess, scheduler.GetJobRecords(),
+                                  scheduler.GetWorkerCount());
+        }
+
+        jobTimings.Record(scheduler.GetJobRecords());
+        jobTimings.Save();
+
+        if (request.verbose) {
+            std::cout << "Peak parallel jobs: " << scheduler.GetPeakConcurrency() << "\n";
+            std::cout << "Estimated memory per job: "
+                      << (scheduler.GetJobMemoryEstimate() >> 20) << " MB\n";
+        }
+    }
+    catch (const std::exception& e) {
+        result.errors.push_back(std::string("Fatal error: ") + e.what());
+        result.success = false;
+    }
+
+    return result;
+}
+
+JobTimings& Generator::Impl::GetTimings(const std::string& outputDir) {
+    std::lock_guard<std::mutex> lock(cacheMutex);
+
+    std::string key = GetCacheKey(outputDir);
+    auto& entry = timings[key];
+    if (!entry) {
+        entry = std::make_unique<JobTimings>(outputDir);
+        entry->Load();
+    }
+    return *entry;
+}
+
+bool Generator::Impl::FindCachedClasses(const std::string& filePath, const std::string& compilerKey,
+                                        std::vector<ClassInfo>& classes) {
+    std::lock_guard<std::mutex> lock(cacheMutex);
+    auto it = parseCache.find(GetCacheKey(filePath));
+    if (it == parseCache.end() || it->second.compilerKey != compilerKey) {
+        return false;
+    }
+
+    // An edited base class or field type changes offsets and sizes without touching the file
+    for (const auto& [dependency, writeTime] : it->second.dependencies) {
+        std::error_code error;
+        auto currentTime = std::filesystem::last_write_time(dependency, error);
+        if (error || currentTime != writeTime) {
+            return false;
+        }
+    }
+
+    classes = it->second.classes;
+    return true;
+}
+
+void Generator::Impl::StoreCachedClasses(const std::string& filePath, const std::string& compilerKey,
+                                         const std::vector<ClassInfo>& classes,
+                                         const std::vector<std::string>& dependencies) {
+    // Failed parses throw before reaching the cache, a file without classes is not worth an entry
+    if (classes.empty()) {
+        return;
+    }
+
+    CachedParse entry{{}, compilerKey, classes};
+    std::vector<std::string> paths = dependencies;
+    if (std::find(paths.begin(), paths.end(), filePath) == paths.end()) {
+        paths.push_back(filePath);
+    }
+    for (const auto& path : paths) {
+        std::error_code error;
+        auto writeTime = std::filesystem::last_write_time(path, error);
+        if (error) {
+            return;
+        }
+        entry.dependencies.emplace_back(path, writeTime);
+    }
+
+    std::lock_guard<std::mutex> lock(cacheMutex);
+    parseCache[GetCacheKey(filePath)] = std::move(entry);
+}
+
+std::string Generator::Impl::GetCompilerKey(const GenerationRequest& request) {
+    std::string key;
+    for (const auto& includeDir : request.includeDirs) {
+        key += "-I" + includeDir + '\n';
+    }
+    for (const auto& definition : request.definitions) {
+        key += "-D" + definition + '\n';
+    }
+    return key;
+}
+
+std::string Generator::Impl::GetCacheKey(const std::string& filePath) {
+    std::error_code error;
+    auto absolutePath = std::filesystem::absolute(filePath, error);
+    return error ? filePath : absolutePath.lexically_normal().string();
+}
+
+} // namespace ReflectionGenerator
@@ -0,0 +1,100 @@
+#pragma once
+
+#include "JobScheduler.h"
+#include "CodeGenerator.h"
+#include <string>
+#include <vector>
+#include <memory>
+
+namespace ReflectionGenerator {
+
+/**
+ * One module to generate reflection code for
+ */
+struct GenerationRequest {
+    // Directories to scan for reflection-enabled headers (ignored if inputFiles is set)
+    std::vector<std::string> scanDirs;
+
+    // Specific files to process
+    std::vector<std::string> inputFiles;
+
+    // Output directory for generated files
+    std::string outputDir = "Build/Generated";
+
+    // Include directories and preprocessor definitions, empty means parser defaults
+    std::vector<std::string> includeDirs;
+    std::vector<std::string> definitions;
+
+    // Parallel parse limits
+    SchedulerOptions scheduler;
+
+    // Shape of the generated code
+    GeneratorOptions generator;
+
+    // Flavors to emit from a single parse, each into outputDir/<flavor>.
+    // Empty means one tree in outputDir using generator.flavor.
+    std::vector<GenerationFlavor> flavors;
+
+    // Path of a size, padding and cache line report for every class, empty to skip it
+    std::string layoutReport;
+
+    // Hand each file's classes straight to code generation and keep only a compact
+    // summary, so memory stays bounded regardless of the number of headers
+    bool streaming = false;
+
+    // Diagnostics printed to standard output
+    bool verbose = false;
+    bool trace = false;
+};
+
+/**
+ * Outcome of a single GenerationRequest
+ */
+struct GenerationResult {
+    bool success = true;
+    int filesProcessed = 0;
+    int filesFromCache = 0;
+    int classesGenerated = 0;
+    std::vector<std::string> errors;
+};
+
+/**
+ * In-process entry point of the reflection generator.
+ *
+ * A Generator keeps scan results, parsed class information and parse timings between
+ * calls, so a long-lived host process can regenerate many modules without paying
+ * process startup and re-parsing unchanged headers. The CLI is a thin wrapper around it.
+ */
+class Generator {
+public:
+    Generator();
+    ~Generator();
+
+    Generator(const Generator&) = delete;
+    Generator& operator=(const Generator&) = delete;
+
+    /**
+     * Generate reflection code for one module
+     * @param request Files, flags and output directory
+     * @return Counters and errors of the run
+     */
+    GenerationResult Generate(const GenerationRequest& request);
+
+    /**
+     * Generate reflection code for a batch of modules, sharing caches between them
+     * @param requests Modules to generate
+     * @return One result per request, in the same order
+     */
+    std::vector<GenerationResult> Generate(const std::vector<GenerationRequest>& requests);
+
+    /**
+     * Drop all cached scan, parse and timing data
+     */
+    void ClearCaches();
+
+private:
+    struct Impl;
+    std::unique_ptr<Impl> m_impl;
+};
+
+} // namespace ReflectionGenerator
@@ -1,32 +1,35 @@
-#include "ClassParser.h"
-#include "CodeGenerator.h"
-#include "FileScanner.h"
+#include "ReflectionGenerator.h"
 #include <iostream>
-#include <filesystem>
 #include <vector>
 #include <string>
 
-namespace fs = std::filesystem;
-
 void PrintUsage(const char* programName) {
     std::cout << "Usage: " << programName << " [options]\n";
     std::cout << "Options:\n";
     std::cout << "  --scan-dirs <dir1,dir2,...>  Directories to scan for reflection-enabled classes\n";
     std::cout << "  --output-dir <dir>           Output directory for generated files\n";
     std::cout << "  --input-files <file1,file2>  Specific files to process\n";
+    std::cout << "  --jobs <n>                   Maximum number of parallel parse jobs (default: CPU count)\n";
+    std::cout << "  --max-memory <size>          Memory budget for parsing, e.g. 4G or 512M (default: unlimited)\n";
+    std::cout << "  --lean-includes              Emit only the includes each generated file needs\n";
+    std::cout << "  --static-descriptors         Describe types with constexpr tables instead of heap-built GTypes\n";
+    std::cout << "  --lazy-registration          Register types from a per-module table on first lookup\n";
+    std::cout << "  --module-name <name>         Name of the module's generated symbols (default: output directory name)\n";
+    std::cout << "  --flavors <editor,runtime>   Emit one output tree per build flavor from a single parse\n";
+    std::cout << "  --layout-report <file>       Write size, padding and cache line usage of every class\n";
+    std::cout << "  --streaming                  Generate each file right after parsing, keep only class summaries\n";
+    std::cout << "  --trace                      Print expected and actual critical path of the parse\n";
     std::cout << "  --verbose                   Enable verbose output\n";
     std::cout << "  --help                      Show this help message\n";
     std::cout << "\n";
     std::cout << "Examples:\n";
     std::cout << "  " << programName << " --scan-dirs Engine,Game --output-dir Build/Generated\n";
     std::cout << "  " << programName << " --input-files Engine/Public/Core/Player.h --output-dir Build/Generated\n";
+    std::cout << "  " << programName << " --scan-dirs Engine,Game --output-dir Build/Generated --max-memory 8G\n";
 }
 
 int main(int argc, char* argv[]) {
-    std::vector<std::string> scanDirs;
-    std::vector<std::string> inputFiles;
-    std::string outputDir = "Build/Generated";
-    bool verbose = false;
+    ReflectionGenerator::GenerationRequest request;
 
     // Parse command line arguments
     for (int i = 1; i < argc; ++i) {
@@ -37,7 +40,46 @@ int main(int argc, char* argv[]) {
             return 0;
         }
         else if (arg == "--verbose" || arg == "-v") {
-            verbose = true;
+            request.verbose = true;
+        }
+        else if (arg == "--lean-includes") {
+            request.generator.leanIncludes = true;
+        }
+        else if (arg == "--static-descriptors") {
+            request.generator.staticDescriptors = true;
+        }
+        else if (arg == "--lazy-registration") {
+            request.generator.lazyRegistration = true;
+        }
+        else if (arg == "--module-name" && i + 1 < argc) {
+            request.generator.moduleName = argv[++i];
+        }
+        else if (arg == "--flavors" && i + 1 < argc) {
+            std::string flavors = argv[++i];
+            size_t pos = 0;
+            while (pos <= flavors.length()) {
+                size_t nextPos = flavors.find(',', pos);
+                if (nextPos == std::string::npos) {
+                    nextPos = flavors.length();
+                }
+                std::string name = flavors.substr(pos, nextPos - pos);
+                ReflectionGenerator::GenerationFlavor flavor;
+                if (!ReflectionGenerator::CodeGenerator::ParseFlavorName(name, flavor)) {
+                    std::cerr << "Unknown flavor: " << name << "\n";
+                    return 1;
+                }
+                request.flavors.push_back(flavor);
+                pos = nextPos + 1;
+            }
+        }
+        else if (arg == "--layout-report" && i + 1 < argc) {
+            request.layoutReport = argv[++i];
+        }
+        else if (arg == "--streaming") {
+            request.streaming = true;
+        }
+        else if (arg == "--trace") {
+            request.trace = true;
         }
         else if (arg == "--scan-dirs" && i + 1 < argc) {
             std::string dirs = argv[++i];
@@ -45,10 +87,10 @@ int main(int argc, char* argv[]) {
             while (pos < dirs.length()) {
                 size_t nextPos = dirs.find(',', pos);
                 if (nextPos == std::string::npos) {
-                    scanDirs.push_back(dirs.substr(pos));
+                    request.scanDirs.push_back(dirs.substr(pos));
                     break;
                 }
-                scanDirs.push_back(dirs.substr(pos, nextPos - pos));
+                request.scanDirs.push_back(dirs.substr(pos, nextPos - pos));
                 pos = nextPos + 1;
             }
         }
@@ -58,15 +100,26 @@ int main(int argc, char* argv[]) {
             while (pos < files.length()) {
                 size_t nextPos = files.find(',', pos);
                 if (nextPos == std::string::npos) {
-                    inputFiles.push_back(files.substr(pos));
+                    request.inputFiles.push_back(files.substr(pos));
                     break;
                 }
-                inputFiles.push_back(files.substr(pos, nextPos - pos));
+                request.inputFiles.push_back(files.substr(pos, nextPos - pos));
                 pos = nextPos + 1;
             }
         }
         else if (arg == "--output-dir" && i + 1 < argc) {
-            outputDir = argv[++i];
+            request.outputDir = argv[++i];
+        }
+        else if (arg == "--jobs" && i + 1 < argc) {
+            request.scheduler.maxWorkers = static_cast<unsigned>(std::stoul(argv[++i]));
+        }
+        else if (arg == "--max-memory" && i + 1 < argc) {
+            std::string size = argv[++i];
+            request.scheduler.maxMemoryBytes = ReflectionGenerator::JobScheduler::ParseMemorySize(size);
+            if (request.scheduler.maxMemoryBytes == 0) {
+                std::cerr << "Invalid memory size: " << size << "\n";
+                return 1;
+            }
         }
         else {
             std::cerr << "Unknown argument: " << arg << "\n";
@@ -75,74 +128,27 @@ int main(int argc, char* argv[]) {
         }
     }
 
-    if (scanDirs.empty() && inputFiles.empty()) {
+    if (request.scanDirs.empty() && request.inputFiles.empty()) {
         std::cerr << "Error: No input directories or files specified\n";
         PrintUsage(argv[0]);
         return 1;
     }
 
-    try {
-        // Create output directory
-        fs::create_directories(outputDir);
-
-        ReflectionGenerator::FileScanner scanner;
-        ReflectionGenerator::ClassParser parser;
-        ReflectionGenerator::CodeGenerator generator(outputDir);
-
-        std::vector<std::string> filesToProcess;
+    ReflectionGenerator::Generator generator;
+    ReflectionGenerator::GenerationResult result = generator.Generate(request);
 
-        // Collect files to process
-        if (!inputFiles.empty()) {
-            filesToProcess = inputFiles;
-        } else {
-            for (const auto& dir : scanDirs) {
-                if (verbose) {
-                    std::cout << "Scanning directory: " << dir << "\n";
-                }
-                auto files = scanner.ScanDirectory(dir);
-                filesToProcess.insert(filesToProcess.end(), files.begin(), files.end());
-            }
-        }
-
-        if (verbose) {
-            std::cout << "Found " << filesToProcess.size() << " files to process\n";
-        }
-
-        int processedCount = 0;
-        int generatedCount = 0;
-
-        // Process each file
-        for (const auto& filePath : filesToProcess) {
-            if (verbose) {
-                std::cout << "Processing: " << filePath << "\n";
-            }
-
-            try {
-                auto classes = parser.ParseFile(filePath);
-                if (!classes.empty()) {
-                    generator.GenerateCode(filePath, classes);
-                    generatedCount += classes.size();
-                    if (verbose) {
-                        std::cout << "  Generated reflection for " << classes.size() << " classes\n";
-                    }
-                }
-                processedCount++;
-            }
-            catch (const std::exception& e) {
-                std::cerr << "Error processing " << filePath << ": " << e.what() << "\n";
-            }
-        }
-
-        std::cout << "Reflection generation completed:\n";
-        std::cout << "  Files processed: " << processedCount << "\n";
-        std::cout << "  Classes generated: " << generatedCount << "\n";
-        std::cout << "  Output directory: " << outputDir << "\n";
-
-        return 0;
+    for (const auto& error : result.errors) {
+        std::cerr << error << "\n";
     }
-    catch (const std::exception& e) {
-        std::cerr << "Fatal error: " << e.what() << "\n";
+
+    if (!result.success) {
         return 1;
     }
-}
 
+    std::cout << "Reflection generation completed:\n";
+    std::cout << "  Files processed: " << result.filesProcessed << "\n";
+    std::cout << "  Classes generated: " << result.classesGenerated << "\n";
+    std::cout << "  Output directory: " << request.outputDir << "\n";
+
+    return 0;
+}